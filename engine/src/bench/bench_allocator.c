@@ -0,0 +1,345 @@
+#include "teleios/teleios.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(TL_PLATFORM_WINDOWS)
+#   include <psapi.h>
+#else
+#   include <sys/resource.h>
+#endif
+
+#if defined(__GLIBC__)
+#   include <malloc.h>
+#endif
+
+// Object size of the fixed-size patterns
+#define BENCH_OBJECT_SIZE 64
+
+// Live objects in the mixed pattern; bump allocators are reset every time it wraps
+#define BENCH_MIXED_WINDOW 1024
+
+// Mixed sizes are 16 << (0..4): 16, 32, 64, 128 and 256 bytes
+#define BENCH_MIXED_SHIFTS 5
+#define BENCH_MIXED_MAXIMUM (16u << (BENCH_MIXED_SHIFTS - 1))
+
+// First page / chunk of the growing bump allocators
+#define BENCH_ARENA_PAGE TL_KIBI_BYTES(64)
+
+typedef enum {
+    BENCH_PATTERN_LIFO,
+    BENCH_PATTERN_FIFO,
+    BENCH_PATTERN_RANDOM,
+    BENCH_PATTERN_MIXED,
+    BENCH_PATTERN_CROSS_THREAD,
+    BENCH_PATTERN_MAXIMUM
+} BenchPattern;
+
+static const char* m_pattern_names[BENCH_PATTERN_MAXIMUM] = {
+    "lifo", "fifo", "random_free", "mixed_sizes", "cross_thread_free"
+};
+
+static const struct {
+    TLAllocatorType type;
+    const char* name;
+} m_allocators[] = {
+    { TL_ALLOCATOR_LINEAR,  "TL_ALLOCATOR_LINEAR"  },
+    { TL_ALLOCATOR_DYNAMIC, "TL_ALLOCATOR_DYNAMIC" },
+    { TL_ALLOCATOR_SLAB,    "TL_ALLOCATOR_SLAB"    },
+    { TL_ALLOCATOR_SHARED,  "TL_ALLOCATOR_SHARED"  },
+    { TL_ALLOCATOR_FRAME,   "TL_ALLOCATOR_FRAME"   },
+    { TL_ALLOCATOR_STACK,   "TL_ALLOCATOR_STACK"   },
+    { TL_ALLOCATOR_VIRTUAL, "TL_ALLOCATOR_VIRTUAL" },
+};
+
+#define BENCH_ALLOCATOR_COUNT (sizeof(m_allocators) / sizeof(m_allocators[0]))
+
+typedef struct {
+    u64 operations;     // Allocations plus frees
+    u64 elapsed;        // Nanoseconds spent in them
+    u64 peak_bytes;     // Allocator high-water mark
+    u64 rss_bytes;      // RSS growth at the pattern's peak over the baseline
+} BenchResult;
+
+// ---------------------------------
+// Helpers
+// ---------------------------------
+
+static u64 bench_now_nanos(void) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (u64)now.tv_sec * 1000000000ULL + (u64)now.tv_nsec;
+}
+
+static u64 m_seed;
+
+static u32 bench_random(void) {
+    // xorshift64: every run, allocator and commit sees the same sequence
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 7;
+    m_seed ^= m_seed << 17;
+    return (u32)(m_seed >> 32);
+}
+
+static u64 bench_rss_current(void) {
+#if defined(TL_PLATFORM_WINDOWS)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return (u64)counters.WorkingSetSize;
+#elif defined(TL_PLATFORM_LINUX)
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (file == NULL) return 0;
+
+    unsigned long size = 0, resident = 0;
+    const int fields = fscanf(file, "%lu %lu", &size, &resident);
+    fclose(file);
+    if (fields != 2) return 0;
+
+    return (u64)resident * (u64)sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+
+static u64 bench_rss_peak(void) {
+#if defined(TL_PLATFORM_WINDOWS)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return (u64)counters.PeakWorkingSetSize;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#   if defined(__APPLE__)
+    return (u64)usage.ru_maxrss;
+#   else
+    return (u64)usage.ru_maxrss * 1024;
+#   endif
+#endif
+}
+
+// Hand freed heap memory back to the OS so each run starts from a comparable RSS
+static void bench_heap_trim(void) {
+#if defined(TL_PLATFORM_WINDOWS)
+    HeapCompact(GetProcessHeap(), 0);
+#elif defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+}
+
+static b8 bench_is_bump(const TLAllocatorType type) {
+    return type != TL_ALLOCATOR_DYNAMIC && type != TL_ALLOCATOR_SLAB && type != TL_ALLOCATOR_SHARED;
+}
+
+// FRAME and VIRTUAL cannot grow past their size, give them the pattern's worst case
+static u32 bench_arena_size(const TLAllocatorType type, const BenchPattern pattern, const u32 count) {
+    if (!bench_is_bump(type)) return 0;
+    if (type == TL_ALLOCATOR_LINEAR || type == TL_ALLOCATOR_STACK) return BENCH_ARENA_PAGE;
+
+    const u64 objects = pattern == BENCH_PATTERN_MIXED ? BENCH_MIXED_WINDOW : count;
+    const u64 object = pattern == BENCH_PATTERN_MIXED ? BENCH_MIXED_MAXIMUM : BENCH_OBJECT_SIZE;
+    const u64 bytes = objects * ((object + 15) & ~15ull) + BENCH_ARENA_PAGE;
+    return bytes > 0xFFFFFFFFull ? 0xFFFFFFFFu : (u32)bytes;
+}
+
+static void bench_track(BenchResult* result, const u64 live, const u64 baseline) {
+    if (live > result->peak_bytes) result->peak_bytes = live;
+
+    const u64 rss = bench_rss_current();
+    if (rss > baseline && rss - baseline > result->rss_bytes) result->rss_bytes = rss - baseline;
+}
+
+// ---------------------------------
+// Cross-thread free
+// ---------------------------------
+
+typedef struct {
+    TLAllocator* allocator;
+    void** objects;
+    u32 count;
+} BenchRelease;
+
+static void* bench_release_worker(void* argument) {
+    BenchRelease* release = argument;
+    for (u32 i = 0; i < release->count; ++i) {
+        tl_memory_free(release->allocator, release->objects[i]);
+    }
+
+    return NULL;
+}
+
+// ---------------------------------
+// Patterns
+// ---------------------------------
+
+static void bench_run_fixed(TLAllocator* allocator, const BenchPattern pattern, void** objects, u32* order, const u32 count, BenchResult* result, const u64 baseline) {
+    if (pattern == BENCH_PATTERN_RANDOM) {
+        // Shuffled before the clock starts
+        for (u32 i = 0; i < count; ++i) order[i] = i;
+        for (u32 i = count - 1; i > 0; --i) {
+            const u32 j = bench_random() % (i + 1);
+            const u32 swap = order[i];
+            order[i] = order[j];
+            order[j] = swap;
+        }
+    }
+
+    u64 start = bench_now_nanos();
+    for (u32 i = 0; i < count; ++i) {
+        objects[i] = tl_memory_alloc(allocator, TL_MEMORY_BLOCK, BENCH_OBJECT_SIZE);
+    }
+    result->elapsed += bench_now_nanos() - start;
+
+    // Outside the clock: callers write what they allocate, and untouched
+    // pages would not show up in the RSS at all
+    for (u32 i = 0; i < count; ++i) {
+        memset(objects[i], 0xA5, BENCH_OBJECT_SIZE);
+    }
+
+    bench_track(result, (u64)count * BENCH_OBJECT_SIZE, baseline);
+
+    start = bench_now_nanos();
+    switch (pattern) {
+        case BENCH_PATTERN_LIFO:
+            for (u32 i = count; i > 0; --i) tl_memory_free(allocator, objects[i - 1]);
+            break;
+        case BENCH_PATTERN_FIFO:
+            for (u32 i = 0; i < count; ++i) tl_memory_free(allocator, objects[i]);
+            break;
+        case BENCH_PATTERN_RANDOM:
+            for (u32 i = 0; i < count; ++i) tl_memory_free(allocator, objects[order[i]]);
+            break;
+        case BENCH_PATTERN_CROSS_THREAD: {
+            BenchRelease release = { allocator, objects, count };
+            TLThread* worker = tl_thread_create(global->allocator, bench_release_worker, &release);
+            tl_thread_join(worker, NULL);
+        } break;
+        default:
+            break;
+    }
+    result->elapsed += bench_now_nanos() - start;
+
+    result->operations = (u64)count * 2;
+}
+
+static void bench_run_mixed(TLAllocator* allocator, const TLAllocatorType type, void** objects, u32* plan, const u32 count, BenchResult* result, const u64 baseline) {
+    u32 sizes[BENCH_MIXED_WINDOW] = { 0 };
+    u64 live = 0;
+
+    // Sizes and slots are drawn up front so the clock only sees the allocator
+    for (u32 i = 0; i < count; ++i) plan[i] = bench_random();
+
+    const u64 start = bench_now_nanos();
+    for (u32 i = 0; i < count; ++i) {
+        const u32 slot = plan[i] % BENCH_MIXED_WINDOW;
+        if (objects[slot] != NULL) {
+            tl_memory_free(allocator, objects[slot]);
+            live -= sizes[slot];
+            result->operations++;
+        }
+
+        sizes[slot] = 16u << ((plan[i] >> 16) % BENCH_MIXED_SHIFTS);
+        objects[slot] = tl_memory_alloc(allocator, TL_MEMORY_BLOCK, sizes[slot]);
+        live += sizes[slot];
+        result->operations++;
+        if (live > result->peak_bytes) result->peak_bytes = live;
+
+        // Bump allocators only give memory back on reset, treat every window as a frame
+        if (bench_is_bump(type) && i % BENCH_MIXED_WINDOW == BENCH_MIXED_WINDOW - 1) {
+            tl_memory_allocator_reset(allocator);
+            memset(objects, 0, sizeof(void*) * BENCH_MIXED_WINDOW);
+            memset(sizes, 0, sizeof(sizes));
+            live = 0;
+        }
+    }
+
+    for (u32 slot = 0; slot < BENCH_MIXED_WINDOW; ++slot) {
+        if (objects[slot] == NULL) continue;
+        tl_memory_free(allocator, objects[slot]);
+        result->operations++;
+    }
+    result->elapsed = bench_now_nanos() - start;
+
+    bench_track(result, result->peak_bytes, baseline);
+}
+
+static BenchResult bench_run(const TLAllocatorType type, const BenchPattern pattern, const u32 count) {
+    BenchResult result = { 0 };
+    m_seed = 0x9E3779B97F4A7C15ULL;
+
+    const u32 slots = pattern == BENCH_PATTERN_MIXED ? BENCH_MIXED_WINDOW : count;
+    // Bookkeeping is allocated and faulted in before the baseline
+    void** objects = malloc(sizeof(void*) * slots);
+    u32* script = malloc(sizeof(u32) * count);
+    memset(objects, 0, sizeof(void*) * slots);
+    memset(script, 0, sizeof(u32) * count);
+
+    bench_heap_trim();
+    const u64 baseline = bench_rss_current();
+    TLAllocator* allocator = tl_memory_allocator_create(bench_arena_size(type, pattern, count), type);
+
+    if (pattern == BENCH_PATTERN_MIXED) {
+        bench_run_mixed(allocator, type, objects, script, count, &result, baseline);
+    } else {
+        bench_run_fixed(allocator, pattern, objects, script, count, &result, baseline);
+    }
+
+    // Telemetry knows what the allocator really handed out (SLAB classes, alignment)
+    const TLMemoryStats stats = tl_memory_stats_allocator(allocator);
+    if (stats.peak_bytes > 0) result.peak_bytes = stats.peak_bytes;
+
+    tl_memory_allocator_destroy(allocator);
+    free(script);
+    free(objects);
+    return result;
+}
+
+// ---------------------------------
+// Suite
+// ---------------------------------
+
+void bench_allocator(const u32 count, FILE* json) {
+    printf("\n=== Benchmark: allocator patterns, %u objects each ===\n", count);
+    printf("  %-22s %-18s %12s %12s %12s\n", "allocator", "pattern", "ns/op", "peak KiB", "rss KiB");
+
+    if (json != NULL) {
+        fprintf(json, "{\n");
+#if defined(TELEIOS_BUILD_DEBUG)
+        fprintf(json, "  \"build\": \"debug\",\n");
+#else
+        fprintf(json, "  \"build\": \"release\",\n");
+#endif
+        fprintf(json, "  \"memory_tracking\": %s,\n", TELEIOS_MEMORY_TRACKING ? "true" : "false");
+        fprintf(json, "  \"count\": %u,\n", count);
+        fprintf(json, "  \"results\": [\n");
+    }
+
+    b8 first = true;
+    for (u32 a = 0; a < BENCH_ALLOCATOR_COUNT; ++a) {
+        for (u32 p = 0; p < BENCH_PATTERN_MAXIMUM; ++p) {
+            const BenchResult result = bench_run(m_allocators[a].type, (BenchPattern)p, count);
+            const f64 ns_per_op = result.operations == 0 ? 0.0 : (f64)result.elapsed / (f64)result.operations;
+
+            printf("  %-22s %-18s %12.1f %12.1f %12.1f\n",
+                m_allocators[a].name, m_pattern_names[p], ns_per_op,
+                (f64)result.peak_bytes / 1024.0, (f64)result.rss_bytes / 1024.0);
+
+            if (json == NULL) continue;
+            fprintf(json, "%s    {\"allocator\": \"%s\", \"pattern\": \"%s\", \"operations\": %llu, \"ns_per_op\": %.2f, \"peak_bytes\": %llu, \"rss_bytes\": %llu}",
+                first ? "" : ",\n",
+                m_allocators[a].name, m_pattern_names[p],
+                (unsigned long long)result.operations, ns_per_op,
+                (unsigned long long)result.peak_bytes, (unsigned long long)result.rss_bytes);
+            first = false;
+        }
+    }
+
+    if (json != NULL) {
+        fprintf(json, "\n  ],\n");
+        fprintf(json, "  \"rss_peak_bytes\": %llu\n", (unsigned long long)bench_rss_peak());
+        fprintf(json, "}\n");
+    }
+
+    printf("  process peak RSS: %.1f KiB\n", (f64)bench_rss_peak() / 1024.0);
+    printf("=== End Benchmark ===\n");
+}
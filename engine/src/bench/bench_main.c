@@ -0,0 +1,65 @@
+#include "teleios/teleios.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Forward declarations of benchmark functions
+extern void bench_memory(u32 count);
+extern void bench_allocator(u32 count, FILE* json);
+
+#if defined(TELEIOS_BUILD_DEBUG)
+// Debug DYNAMIC blocks carry a full stack trace each, keep the default small
+#   define BENCH_DEFAULT_COUNT 1000
+#else
+#   define BENCH_DEFAULT_COUNT 1000000
+#endif
+
+// Usage: teleios_bench [count] [--json <file>]
+//
+// With --json the allocator report is also written to <file> so runs can be
+// compared across commits.
+int main(const int argc, char** argv) {
+    u32 count = BENCH_DEFAULT_COUNT;
+    const char* json_path = NULL;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else {
+            count = (u32)strtoul(argv[i], NULL, 10);
+        }
+    }
+
+    FILE* json = NULL;
+    if (json_path != NULL) {
+        json = fopen(json_path, "w");
+        if (json == NULL) {
+            fprintf(stderr, "Failed to open %s\n", json_path);
+            return 1;
+        }
+    }
+
+    printf("========================================\n");
+    printf("   TELEIOS Engine Benchmarks\n");
+    printf("========================================\n");
+
+    // Initialize global state
+    TLGlobal g = {0};
+    global = &g;
+
+    // Benchmarks only exercise engine internals. Keeping the logger quiet means
+    // no platform service (clock, window, graphics thread) has to be started.
+    tl_logger_set_level(TL_LOG_LEVEL_ERROR);
+    if (!tl_memory_initialize()) {
+        fprintf(stderr, "Failed to initialize memory system\n");
+        return 1;
+    }
+
+    if (count == 0) count = BENCH_DEFAULT_COUNT;
+    bench_memory(count);
+    bench_allocator(count, json);
+
+    if (json != NULL) fclose(json);
+
+    tl_memory_terminate();
+    return 0;
+}
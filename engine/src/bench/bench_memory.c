@@ -0,0 +1,190 @@
+#include "teleios/teleios.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Frees through the pre-header DYNAMIC allocator are O(live allocations), so the
+// legacy replica is capped to keep the run in seconds instead of hours.
+#define BENCH_LEGACY_MAXIMUM 20000
+
+// Payload of every benchmark string (21 bytes + terminator)
+static const char* BENCH_STRING = "teleios-bench-string";
+
+// sizeof(struct TLString): data pointer, cached length and allocator pointer
+#define BENCH_STRING_HEADER_SIZE 24
+
+// ---------------------------------
+// Helpers
+// ---------------------------------
+
+static u64 bench_now_nanos(void) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (u64)now.tv_sec * 1000000000ULL + (u64)now.tv_nsec;
+}
+
+static u64 m_seed = 0x9E3779B97F4A7C15ULL;
+
+static u32 bench_random(void) {
+    // xorshift64: deterministic so every run frees in the same order
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 7;
+    m_seed ^= m_seed << 17;
+    return (u32)(m_seed >> 32);
+}
+
+static void bench_shuffle(void** items, const u32 count) {
+    for (u32 i = count - 1; i > 0; --i) {
+        const u32 j = bench_random() % (i + 1);
+        void* swap = items[i];
+        items[i] = items[j];
+        items[j] = swap;
+    }
+}
+
+static void bench_report(const char* name, const u32 count, const u64 elapsed) {
+    printf("  %-32s %9u ops %12.1f ns/op %10.2f ms\n",
+        name, count, (f64)elapsed / (f64)count, (f64)elapsed / 1000000.0);
+}
+
+// ---------------------------------
+// Replica of the DYNAMIC allocator before block headers: one record per
+// allocation kept in a singly linked list that every free searches from the head.
+// ---------------------------------
+
+typedef struct BenchLegacyBlock {
+    void* pointer;
+    struct BenchLegacyBlock* next;
+    u32 size;
+    TLMemoryTag tag;
+} BenchLegacyBlock;
+
+static void* bench_legacy_alloc(BenchLegacyBlock** head, const TLMemoryTag tag, const u32 size) {
+    BenchLegacyBlock* block = malloc(sizeof(BenchLegacyBlock));
+    memset(block, 0, sizeof(BenchLegacyBlock));
+    block->tag = tag;
+    block->size = size;
+    block->next = *head;
+    block->pointer = malloc(size);
+    memset(block->pointer, 0, size);
+    *head = block;
+    return block->pointer;
+}
+
+static void bench_legacy_free(BenchLegacyBlock** head, void* pointer) {
+    BenchLegacyBlock* prev = NULL;
+    BenchLegacyBlock* current = *head;
+
+    while (current != NULL) {
+        if (current->pointer == pointer) {
+            if (prev == NULL) *head = current->next;
+            else prev->next = current->next;
+
+            free(current->pointer);
+            free(current);
+            return;
+        }
+
+        prev = current;
+        current = current->next;
+    }
+}
+
+// ---------------------------------
+// Benchmarks
+// ---------------------------------
+
+static u64 bench_dynamic_free_random(const u32 count) {
+    TLAllocator* allocator = tl_memory_allocator_create(0, TL_ALLOCATOR_DYNAMIC);
+    TLString** strings = malloc(sizeof(TLString*) * count);
+
+    for (u32 i = 0; i < count; ++i) {
+        strings[i] = tl_string_create(allocator, BENCH_STRING);
+    }
+
+    bench_shuffle((void**)strings, count);
+
+    const u64 start = bench_now_nanos();
+    for (u32 i = 0; i < count; ++i) {
+        tl_string_destroy(strings[i]);
+    }
+    const u64 elapsed = bench_now_nanos() - start;
+
+    free(strings);
+    tl_memory_allocator_destroy(allocator);
+    return elapsed;
+}
+
+static u64 bench_legacy_free_random(const u32 count) {
+    BenchLegacyBlock* head = NULL;
+    const u32 length = (u32)strlen(BENCH_STRING) + 1;
+
+    // Each string is two allocations: the TLString header and its characters
+    void** headers = malloc(sizeof(void*) * count);
+    void** payloads = malloc(sizeof(void*) * count);
+    u32* order = malloc(sizeof(u32) * count);
+
+    for (u32 i = 0; i < count; ++i) {
+        headers[i] = bench_legacy_alloc(&head, TL_MEMORY_STRING, BENCH_STRING_HEADER_SIZE);
+        payloads[i] = bench_legacy_alloc(&head, TL_MEMORY_STRING, length);
+        memcpy(payloads[i], BENCH_STRING, length);
+        order[i] = i;
+    }
+
+    for (u32 i = count - 1; i > 0; --i) {
+        const u32 j = bench_random() % (i + 1);
+        const u32 swap = order[i];
+        order[i] = order[j];
+        order[j] = swap;
+    }
+
+    const u64 start = bench_now_nanos();
+    for (u32 i = 0; i < count; ++i) {
+        bench_legacy_free(&head, payloads[order[i]]);
+        bench_legacy_free(&head, headers[order[i]]);
+    }
+    const u64 elapsed = bench_now_nanos() - start;
+
+    free(order);
+    free(payloads);
+    free(headers);
+    return elapsed;
+}
+
+static u64 bench_small_alloc_free(const TLAllocatorType type, const u32 count) {
+    TLAllocator* allocator = tl_memory_allocator_create(0, type);
+    void** objects = malloc(sizeof(void*) * count);
+
+    const u64 start = bench_now_nanos();
+    for (u32 i = 0; i < count; ++i) {
+        objects[i] = tl_memory_alloc(allocator, TL_MEMORY_CONTAINER_NODE, 24);
+    }
+    for (u32 i = 0; i < count; ++i) {
+        tl_memory_free(allocator, objects[i]);
+    }
+    const u64 elapsed = bench_now_nanos() - start;
+
+    free(objects);
+    tl_memory_allocator_destroy(allocator);
+    return elapsed;
+}
+
+void bench_memory(const u32 count) {
+    printf("\n=== Benchmark: DYNAMIC free, %u strings in random order ===\n", count);
+
+    const u32 legacy_count = count < BENCH_LEGACY_MAXIMUM ? count : BENCH_LEGACY_MAXIMUM;
+
+    bench_report("tl_string_destroy (header)", count, bench_dynamic_free_random(count));
+    if (legacy_count != count) {
+        bench_report("tl_string_destroy (header)", legacy_count, bench_dynamic_free_random(legacy_count));
+    }
+    bench_report("linked-list search (legacy)", legacy_count, bench_legacy_free_random(legacy_count));
+
+    printf("=== End Benchmark ===\n");
+
+    printf("\n=== Benchmark: %u small objects (24 bytes), alloc then free ===\n", count);
+    bench_report("TL_ALLOCATOR_DYNAMIC", count, bench_small_alloc_free(TL_ALLOCATOR_DYNAMIC, count));
+    bench_report("TL_ALLOCATOR_SLAB", count, bench_small_alloc_free(TL_ALLOCATOR_SLAB, count));
+    printf("=== End Benchmark ===\n");
+}
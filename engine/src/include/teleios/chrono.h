@@ -42,6 +42,18 @@ static const f64 TL_CHRONO_ONE_SECOND_IN_MICROS = 1000000.0;     ///< 1 second i
  */
 void tl_time_clock(TLDateTime* clock);
 
+/**
+ * @brief Break a tl_time_epoch_millis() timestamp into local date and time
+ *
+ * @param epoch_millis Milliseconds since the Unix epoch
+ * @param clock Pointer to TLDateTime structure to fill (must not be NULL)
+ *
+ * @note Thread-safe on all platforms
+ *
+ * @see tl_time_clock - For the current date and time
+ */
+void tl_time_local(u64 epoch_millis, TLDateTime* clock);
+
 /**
  * @brief Get milliseconds since Unix epoch (January 1, 1970 00:00:00 UTC)
  *
@@ -110,4 +122,20 @@ u64 tl_time_epoch_millis(void);
  */
 u64 tl_time_epoch_micros(void);
 
+/**
+ * @brief Get nanoseconds from an arbitrary fixed point, for measuring intervals
+ *
+ * Unlike the epoch functions this clock never jumps or slews when the system
+ * time is adjusted (CLOCK_MONOTONIC_RAW on Linux, QueryPerformanceCounter on
+ * Windows). Values are only meaningful relative to each other.
+ *
+ * @return Nanoseconds since an unspecified starting point
+ *
+ * @note Thread-safe on all platforms
+ * @note Usable before tl_platform_initialize()
+ *
+ * @see tl_time_epoch_micros - For wall-clock time
+ */
+u64 tl_time_monotonic_nanos(void);
+
 #endif
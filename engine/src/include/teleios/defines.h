@@ -143,7 +143,7 @@ typedef uint32_t    u32;
 /** @brief Unsigned 64-bit integer (0 to 18,446,744,073,709,551,615) */
 typedef uint64_t    u64;
 
-#define U64_MAX     18446744073709551615
+#define U64_MAX     18446744073709551615ULL
 #define U32_MAX     4294967295
 #define U16_MAX     65535
 #define  U8_MAX     255
@@ -442,6 +442,8 @@ typedef struct {
 typedef struct {
     /** @brief Dynamic allocator */
     TLAllocator* allocator;
+    /** @brief Per-frame transient allocator, reset at the start of every frame (main thread only) */
+    TLAllocator* frame_allocator;
     /** @brief Application-wide mutex */
     TLMutex* mutex;
     /** @brief Indicates the simulation is running */
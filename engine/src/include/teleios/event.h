@@ -56,6 +56,15 @@ typedef enum {
     TL_EVENT_INPUT_CURSOR_ENTERED,  ///< Mouse cursor entered window
     TL_EVENT_INPUT_CURSOR_EXITED,   ///< Mouse cursor exited window
 
+    /**
+     * Memory budget soft threshold crossed or limit exceeded
+     * @details event.u32[0] = TLMemoryTag, TL_MEMORY_MAXIMUM for an allocator budget
+     * @details event.u32[1] = percent of the limit in use (above 100 when exceeded)
+     * @details event.u64[1] = address of the TLAllocator, 0 for a tag budget
+     * @see tl_memory_budget_tag
+     */
+    TL_EVENT_MEMORY_PRESSURE,
+
     TL_EVENT_MAXIMUM                ///< Sentinel value marking end of predefined events
 } TLEventCodes;
 
@@ -59,6 +59,212 @@ TLLogLevel tl_logger_get_level(void);
  */
 void tl_logger_write(TLLogLevel level, const char *filename, u32 lineno, const char *message, ...);
 
+/**
+ * @brief Move stdout writes to a dedicated writer thread
+ *
+ * Once started, tl_logger_write formats the line into a lock-free ring and
+ * returns; the writer thread batches queued lines into large writes. When the
+ * ring is full the caller waits for room, lines are never dropped. The output
+ * is byte-identical to the synchronous mode.
+ *
+ * Enabled at startup by `teleios.logging.async: true`.
+ *
+ * @return false if asynchronous mode is already running or could not start
+ *
+ * @note Requires the memory system (thread and mutex come from the global allocator)
+ *
+ * @see tl_logger_async_end
+ * @see tl_logger_flush
+ */
+b8 tl_logger_async_begin(void);
+
+/**
+ * @brief Drain the ring, stop the writer thread and return to synchronous writes
+ *
+ * Called by tl_platform_terminate before the memory system shuts down.
+ */
+void tl_logger_async_end(void);
+
+/**
+ * @brief Block until every line logged so far reached stdout
+ *
+ * Called automatically for FATAL messages before the process exits.
+ */
+void tl_logger_flush(void);
+
+/**
+ * @brief Destinations of text log lines, combined as a mask
+ */
+typedef enum {
+    TL_LOG_SINK_CONSOLE = 1 << 0,   ///< stdout with ANSI colors (through the writer thread in async mode)
+    TL_LOG_SINK_FILE    = 1 << 1    ///< The memory-mapped file of tl_logger_file_begin(), colors stripped
+} TLLogSink;
+
+/**
+ * @brief Choose the sinks a level is written to
+ *
+ * Every level goes to every sink by default. The global threshold of
+ * tl_logger_set_level() still applies first.
+ *
+ * tl_platform_initialize() applies `teleios.logging.console.level` and
+ * `teleios.logging.file.level` as the lowest level each sink receives.
+ *
+ * @param level Level to route
+ * @param sinks Mask of TLLogSink, 0 drops the level
+ */
+void tl_logger_set_sinks(TLLogLevel level, u8 sinks);
+u8 tl_logger_get_sinks(TLLogLevel level);
+
+/**
+ * @brief Open the file sink
+ *
+ * Lines are copied into a preallocated, memory-mapped segment, so writing
+ * one costs no syscall. A full segment is rotated: `path` becomes `path.1`,
+ * `path.1` becomes `path.2` and so on, keeping `rotations` old segments.
+ * Closed segments are cut to the bytes actually written.
+ *
+ * Configured from `teleios.logging.file` (`path`, `megabytes`, `rotations`).
+ *
+ * @param path File of the current segment, truncated if it exists
+ * @param segment Bytes per segment, at least 64 KiB
+ * @param rotations Old segments kept, 0 discards a full segment
+ * @return false if the sink is already open or the file cannot be mapped
+ *
+ * @see tl_logger_file_end
+ */
+b8 tl_logger_file_begin(const char* path, u64 segment, u32 rotations);
+
+/**
+ * @brief Close the file sink, cutting the segment to its used size
+ *
+ * Called automatically for FATAL messages before the process exits.
+ */
+void tl_logger_file_end(void);
+
+/**
+ * @brief Static descriptor of a TLVERBOSE/TLTRACE/TLDEBUG call site
+ *
+ * Declared by the macros, so the binary log only records the site id, a
+ * timestamp and the raw arguments instead of formatting the line.
+ */
+typedef struct {
+    TLLogLevel level;
+    u32 lineno;
+    const char* filename;
+    const char* format;
+    _Atomic u32 id;         ///< Assigned the first time the site reaches a binary log, 0 before
+    _Atomic u32 session;    ///< Binary log the site was last described in
+} TLLogSite;
+
+/**
+ * @brief Write a log message through its call site descriptor
+ *
+ * Same output as tl_logger_write() while no binary log is open. With one
+ * open the message goes to the binary log unformatted.
+ *
+ * @see tl_logger_binary_begin
+ */
+void tl_logger_site_write(TLLogSite* site, ...);
+
+/**
+ * @brief Send TLVERBOSE/TLTRACE/TLDEBUG messages to a binary file
+ *
+ * Each call then costs a format scan and a copy into a per-thread buffer,
+ * no vsnprintf. Strings are copied (up to 255 bytes), every other argument
+ * is stored as a raw word. teleios_logdecode turns the file back into the
+ * usual text. Higher levels keep writing text to stdout. A `*` width or
+ * precision ends the captured arguments, the decoded text then ends in "...".
+ *
+ * Enabled at startup by `teleios.logging.binary.path`.
+ *
+ * @param path File to create, truncated if it exists
+ * @return false if a binary log is already open or the file cannot be created
+ */
+b8 tl_logger_binary_begin(const char* path);
+
+/**
+ * @brief Flush every thread's buffer and close the binary log
+ */
+void tl_logger_binary_end(void);
+
+/**
+ * @brief Turn a binary log back into the text format of tl_logger_write()
+ *
+ * @param input Binary log opened for reading ("rb")
+ * @param output Destination of the text lines
+ * @return false if the input is not a binary log or is corrupted
+ */
+b8 tl_logger_binary_decode(FILE* input, FILE* output);
+
+/**
+ * @brief Static token bucket of a TL_LOG_LIMITED/TLWARN_LIMITED call site
+ *
+ * Starts empty, the first message fills it to `burst`. Once spent it refills
+ * at `rate` tokens a second, messages arriving without a token are counted
+ * and reported as "Suppressed N similar messages" from the same site.
+ */
+typedef struct TLLogLimit {
+    TLLogLevel level;
+    u32 lineno;
+    const char* filename;
+    u32 rate;                       ///< Tokens added per second, 0 never refills after the first burst
+    u32 burst;                      ///< Bucket capacity, messages let through back to back
+    _Atomic i32 tokens;
+    _Atomic u64 refilled;           ///< tl_time_epoch_millis() the tokens were last counted at, 0 before the first message
+    _Atomic u32 suppressed;         ///< Messages dropped since the last one let through
+    struct TLLogLimit* next;        ///< Sites already used, for tl_logger_limit_flush()
+} TLLogLimit;
+
+/**
+ * @brief Refill an empty bucket from the clock, see tl_logger_limit_acquire
+ */
+b8 tl_logger_limit_refill(TLLogLimit* limit);
+
+/**
+ * @brief Take a token from a call site's bucket
+ *
+ * A load and a compare-exchange while the bucket holds tokens, the clock is
+ * only read once it is empty. Reports the messages suppressed so far when a
+ * refill lets one through again.
+ *
+ * @return false if the message must be dropped
+ */
+static inline b8 tl_logger_limit_acquire(TLLogLimit* limit) {
+    i32 tokens = atomic_load_explicit(&limit->tokens, memory_order_relaxed);
+    if (tokens > 0 && atomic_compare_exchange_weak_explicit(&limit->tokens, &tokens, tokens - 1, memory_order_relaxed, memory_order_relaxed)) {
+        return true;
+    }
+
+    return tl_logger_limit_refill(limit);
+}
+
+/**
+ * @brief Report what every rate limited site suppressed since its last message
+ *
+ * Called at shutdown, so a site that went quiet still tells how much it dropped.
+ */
+void tl_logger_limit_flush(void);
+
+#if ! defined(TELEIOS_LOG_LIMIT_RATE)
+#   define TELEIOS_LOG_LIMIT_RATE 1         // Messages per second once a site spent its burst
+#endif
+
+#if ! defined(TELEIOS_LOG_LIMIT_BURST)
+#   define TELEIOS_LOG_LIMIT_BURST 5        // Messages a site lets through back to back
+#endif
+
+/**
+ * @brief Log through a per call site token bucket
+ *
+ * For messages that may fire every frame or every call. `tl_rate` and
+ * `tl_burst` must be constants, they initialize the site's static TLLogLimit.
+ *
+ * @code
+ * TL_LOG_LIMITED(TL_LOG_LEVEL_INFO, 2, 10, "Resampling %s", name)
+ * @endcode
+ */
+#define TL_LOG_LIMITED(tl_level, tl_rate, tl_burst, m, ...) { static TLLogLimit tl_log_limit = { .level = tl_level, .lineno = __LINE__, .filename = __FILE__, .rate = tl_rate, .burst = tl_burst }; if (tl_logger_limit_acquire(&tl_log_limit)) tl_logger_write(tl_level, __FILE__, __LINE__, m, ##__VA_ARGS__); }
+
 /**
  * @brief Log very detailed diagnostic information
  *
@@ -81,7 +287,7 @@ void tl_logger_write(TLLogLevel level, const char *filename, u32 lineno, const c
  * @endcode
  */
 #if defined(TELEIOS_BUILD_DEBUG)
-#   define TLVERBOSE(m, ...) { tl_logger_write(TL_LOG_LEVEL_VERBOSE, __FILE__, __LINE__, m, ##__VA_ARGS__); }
+#   define TLVERBOSE(m, ...) { static TLLogSite tl_log_site = { .level = TL_LOG_LEVEL_VERBOSE, .lineno = __LINE__, .filename = __FILE__, .format = m }; tl_logger_site_write(&tl_log_site, ##__VA_ARGS__); }
 #else
 #   define TLVERBOSE(m, ...)
 #endif
@@ -111,7 +317,7 @@ void tl_logger_write(TLLogLevel level, const char *filename, u32 lineno, const c
  * @endcode
  */
 #if defined(TELEIOS_BUILD_DEBUG)
-#   define   TLTRACE(m, ...) { tl_logger_write(TL_LOG_LEVEL_TRACE  , __FILE__, __LINE__, m, ##__VA_ARGS__); }
+#   define   TLTRACE(m, ...) { static TLLogSite tl_log_site = { .level = TL_LOG_LEVEL_TRACE, .lineno = __LINE__, .filename = __FILE__, .format = m }; tl_logger_site_write(&tl_log_site, ##__VA_ARGS__); }
 #else
 #   define   TLTRACE(m, ...)
 #endif
@@ -138,7 +344,7 @@ void tl_logger_write(TLLogLevel level, const char *filename, u32 lineno, const c
  * @endcode
  */
 #if defined(TELEIOS_BUILD_DEBUG)
-#   define   TLDEBUG(m, ...) { tl_logger_write(TL_LOG_LEVEL_DEBUG  , __FILE__, __LINE__, m, ##__VA_ARGS__); }
+#   define   TLDEBUG(m, ...) { static TLLogSite tl_log_site = { .level = TL_LOG_LEVEL_DEBUG, .lineno = __LINE__, .filename = __FILE__, .format = m }; tl_logger_site_write(&tl_log_site, ##__VA_ARGS__); }
 #else
 #   define   TLDEBUG(m, ...)
 #endif
@@ -193,6 +399,20 @@ void tl_logger_write(TLLogLevel level, const char *filename, u32 lineno, const c
  */
 #define    TLWARN(m, ...) { tl_logger_write(TL_LOG_LEVEL_WARN   , __FILE__, __LINE__, m, ##__VA_ARGS__); }
 
+/**
+ * @brief TLWARN for warnings that repeat, limited per call site
+ *
+ * Lets TELEIOS_LOG_LIMIT_BURST messages through, then TELEIOS_LOG_LIMIT_RATE
+ * per second, and reports how many were suppressed in between.
+ *
+ * @see TL_LOG_LIMITED
+ *
+ * @code
+ * TLWARN_LIMITED("Frame time %.2f ms exceeded", frame_ms);
+ * @endcode
+ */
+#define    TLWARN_LIMITED(m, ...) TL_LOG_LIMITED(TL_LOG_LEVEL_WARN, TELEIOS_LOG_LIMIT_RATE, TELEIOS_LOG_LIMIT_BURST, m, ##__VA_ARGS__)
+
 /**
  * @brief Log error messages
  *
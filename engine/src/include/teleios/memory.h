@@ -3,6 +3,26 @@
 
 #include "teleios/defines.h"
 
+/**
+ * @brief Allocation bookkeeping switch
+ *
+ * When 1, DYNAMIC block headers also carry the owner, the live list and, in
+ * debug builds, the allocation stack trace, so leaks are reported one by one
+ * and foreign pointers are rejected. When 0, only the leak count is known.
+ * The tl_memory_stats_* telemetry and the budgets work either way: every
+ * block keeps the tag and size they need.
+ *
+ * Defaults to 1 in debug builds and 0 otherwise. Override with
+ * -DTELEIOS_MEMORY_TRACKING=ON|OFF (CMake cache variable of the same name).
+ */
+#if ! defined(TELEIOS_MEMORY_TRACKING)
+#   if defined(TELEIOS_BUILD_DEBUG)
+#       define TELEIOS_MEMORY_TRACKING 1
+#   else
+#       define TELEIOS_MEMORY_TRACKING 0
+#   endif
+#endif
+
 /**
  * @brief Memory allocation tags for subsystem tracking
  *
@@ -40,9 +60,38 @@ typedef enum {
  */
 typedef enum {
     TL_ALLOCATOR_LINEAR,        ///< Arena allocator - bulk allocation/deallocation
-    TL_ALLOCATOR_DYNAMIC        ///< Heap allocator - individual deallocation with leak detection
+    TL_ALLOCATOR_DYNAMIC,       ///< Heap allocator - individual deallocation with leak detection
+    TL_ALLOCATOR_SLAB,          ///< Size-class allocator - small fixed-size objects from page-sized slabs
+    TL_ALLOCATOR_FRAME,         ///< Double-buffered arena - transient data reset every frame
+    TL_ALLOCATOR_STACK,         ///< Stack arena - scoped scratch memory rewound to a marker
+    TL_ALLOCATOR_VIRTUAL,       ///< Reserved address range - contiguous arena committed on demand
+    TL_ALLOCATOR_SHARED         ///< Thread-safe size-class allocator - per-thread magazine caches over a central depot
 } TLAllocatorType;
 
+/**
+ * @brief Position inside a STACK allocator
+ *
+ * Captured by tl_memory_stack_push_marker() and handed back to
+ * tl_memory_stack_pop_to_marker() to release everything allocated after it.
+ * Treat as opaque.
+ */
+typedef struct {
+    void* chunk;        ///< Chunk that was on top when the marker was taken
+    u32 offset;         ///< Bytes used in that chunk at the time
+} TLMemoryMarker;
+
+/**
+ * @brief Snapshot of a memory telemetry counter
+ *
+ * Returned by tl_memory_stats_tag() and tl_memory_stats_allocator().
+ */
+typedef struct {
+    u64 current_bytes;      ///< Bytes currently allocated
+    u64 peak_bytes;         ///< High-water mark of current_bytes
+    u64 allocation_count;   ///< Allocations since start
+    u64 frame_allocations;  ///< Allocations during the last completed frame
+} TLMemoryStats;
+
 /**
  * @brief Initialize the memory system
  *
@@ -79,18 +128,47 @@ b8 tl_memory_terminate(void);
  * Creates a new allocator instance of the specified type. The size parameter
  * interpretation depends on allocator type:
  *
- * - **LINEAR**: Initial arena size in bytes (memory grows if exhausted)
+ * - **LINEAR**: First page size in bytes (further pages double in size)
  * - **DYNAMIC**: Ignored (set to 0)
- *
- * @param size Arena size for LINEAR allocator, 0 for DYNAMIC allocator
- * @param type Allocator type (LINEAR or DYNAMIC)
+ * - **SLAB**: Ignored (set to 0)
+ * - **FRAME**: Capacity of each of the two frame buffers in bytes (fixed)
+ * - **STACK**: Chunk size in bytes (more chunks are chained when exhausted)
+ * - **VIRTUAL**: Address space to reserve in bytes (the hard limit of the arena)
+ * - **SHARED**: Ignored (set to 0)
+ *
+ * @param size Arena size for LINEAR, FRAME, STACK and VIRTUAL allocators, 0 for DYNAMIC, SLAB and SHARED allocators
+ * @param type Allocator type (LINEAR, DYNAMIC, SLAB, FRAME, STACK, VIRTUAL or SHARED)
  * @return Pointer to newly created allocator, or NULL on failure
  *
  * @note LINEAR allocators are fast but cannot deallocate individual blocks.
  *       Use for subsystems that allocate once and deallocate everything at shutdown.
  *
- * @note DYNAMIC allocators support individual deallocation and track allocations
- *       for leak detection on destruction.
+ * @note DYNAMIC allocators support individual deallocation. With
+ *       TELEIOS_MEMORY_TRACKING they list every leaked allocation on
+ *       destruction, otherwise only the leak count is reported.
+ *
+ * @note SLAB allocators round requests up to a power-of-two size class
+ *       (16 to 512 bytes) served from 4 KiB slabs with a free list per class.
+ *       Meant for container nodes, iterators and string headers; larger
+ *       requests fall back to a dedicated block.
+ *
+ * @note FRAME allocators alternate between two buffers on every
+ *       tl_memory_allocator_reset(). Exceeding the buffer size is fatal, size it
+ *       from tl_memory_frame_peak().
+ *
+ * @note STACK allocators hand out memory by bumping a pointer and release it by
+ *       rewinding to a marker. Prefer tl_memory_scratch() for short-lived scopes.
+ *
+ * @note VIRTUAL allocators reserve the whole range up front and commit it in
+ *       64 KiB steps (2 MiB with huge pages) as the arena grows. Allocations
+ *       never move and sit in one contiguous block. Requires the platform layer.
+ *
+ * @note SHARED allocators are the only ones safe to use from several threads at
+ *       once, and memory may be freed by a different thread than the one that
+ *       allocated it. Size classes match SLAB. Each thread keeps magazines of
+ *       free objects and only touches the shared depot to swap a whole
+ *       magazine; oversize requests take the depot lock. global->allocator is
+ *       one. At most 8 can be alive at the same time, and they cannot be reset.
  *
  * @see tl_memory_allocator_destroy
  * @see tl_memory_alloc
@@ -153,11 +231,13 @@ void tl_memory_allocator_destroy(TLAllocator* allocator);
  * @param size Size in bytes to allocate (must not be 0)
  * @return Pointer to allocated memory, or NULL if allocation failed
  *
- * @note The returned memory is not initialized (may contain garbage).
- *       Use tl_memory_set() to zero-initialize if needed.
+ * @note The returned memory is not initialized (may contain garbage), no
+ *       allocator zeroes on the hot path. Use tl_memory_alloc_zeroed() when
+ *       the caller relies on zero-filled memory.
  *
- * @note LINEAR allocator failures may reallocate the arena (pointer invalidation
- *       for old allocations is possible). Avoid relying on pointer stability.
+ * @note LINEAR allocators only bump the current page. When it is full a new page
+ *       twice as large is chained, and requests larger than the next page get a
+ *       dedicated page. Existing allocations never move.
  *
  * @see tl_memory_allocator_create
  * @see tl_memory_free
@@ -187,17 +267,97 @@ void tl_memory_allocator_destroy(TLAllocator* allocator);
  */
 void* tl_memory_alloc(TLAllocator* allocator, TLMemoryTag tag, u32 size);
 
+/**
+ * @brief Allocate zero-filled memory from an allocator
+ *
+ * Same as tl_memory_alloc() followed by tl_memory_set(pointer, 0, size). Use it
+ * for structures whose fields are not all assigned right after allocation.
+ *
+ * @param allocator Allocator to use (must not be NULL)
+ * @param tag Memory tag for categorization (see TLMemoryTag)
+ * @param size Size in bytes to allocate (must not be 0)
+ * @return Pointer to zero-filled memory
+ *
+ * @see tl_memory_alloc
+ *
+ * @code
+ * TLList* list = tl_memory_alloc_zeroed(allocator, TL_MEMORY_CONTAINER_LIST, sizeof(TLList));
+ * @endcode
+ */
+void* tl_memory_alloc_zeroed(TLAllocator* allocator, TLMemoryTag tag, u32 size);
+
+/**
+ * @brief Allocate memory aligned to a power-of-two boundary
+ *
+ * Same as tl_memory_alloc() but the returned address is a multiple of
+ * `alignment`. Meant for vertex data, cglm vec4/mat4 arrays and SIMD kernels
+ * that rely on aligned loads. Release it with tl_memory_free() as usual.
+ *
+ * @param allocator Allocator to use (must not be NULL)
+ * @param tag Memory tag for categorization (see TLMemoryTag)
+ * @param size Size in bytes to allocate (must not be 0)
+ * @param alignment Power of two; values below alignof(max_align_t) are raised to it
+ * @return Pointer to allocated memory
+ *
+ * @note tl_memory_alloc() already guarantees alignof(max_align_t).
+ * @note SLAB allocators support alignments up to 2 KiB (half a slab).
+ *
+ * @see tl_memory_alloc
+ *
+ * @code
+ * mat4* bones = tl_memory_alloc_aligned(allocator, TL_MEMORY_GRAPHICS, sizeof(mat4) * 64, 32);
+ * @endcode
+ */
+void* tl_memory_alloc_aligned(TLAllocator* allocator, TLMemoryTag tag, u32 size, u32 alignment);
+
+/**
+ * @brief Grow or shrink a block, in place whenever the allocator can
+ *
+ * Behaves like tl_memory_alloc() followed by a copy and tl_memory_free(), but
+ * avoids the copy when the block can be resized where it is:
+ *
+ * - LINEAR, FRAME, STACK and VIRTUAL extend the block in place when it is the
+ *   last allocation and still fits; shrinking never moves.
+ * - DYNAMIC goes through realloc(), so large blocks are remapped by the heap
+ *   instead of copied.
+ * - SLAB keeps the object while it fits its size class or dedicated block.
+ *
+ * Bytes past `old_size` are not initialized, like a fresh allocation.
+ *
+ * @param allocator Allocator that owns the block (must not be NULL)
+ * @param tag Memory tag used if the block has to move
+ * @param pointer Block to resize, NULL behaves like tl_memory_alloc()
+ * @param old_size Size the block was allocated or last resized with
+ * @param new_size New size in bytes (must not be 0)
+ * @return Pointer to the resized block, which may differ from `pointer`
+ *
+ * @note A moved block keeps the alignment of its old address up to 64 bytes.
+ *
+ * @code
+ * items = tl_memory_realloc(allocator, TL_MEMORY_CONTAINER_ARRAY, items, sizeof(void*) * capacity, sizeof(void*) * capacity * 2);
+ * @endcode
+ */
+void* tl_memory_realloc(TLAllocator* allocator, TLMemoryTag tag, void* pointer, u32 old_size, u32 new_size);
+
 /**
  * @brief Free memory allocated from an allocator
  *
  * Deallocates a block of memory previously allocated with tl_memory_alloc().
  *
  * **For LINEAR allocators:** This is a no-op. Memory cannot be individually
- * freed from LINEAR allocators. Use tl_memory_allocator_destroy() to free
- * all memory at once.
+ * freed from LINEAR allocators. Use tl_memory_allocator_reset() to reuse the
+ * pages or tl_memory_allocator_destroy() to free all memory at once.
  *
  * **For DYNAMIC allocators:** The memory block is returned to the allocator
- * for reuse. The pointer becomes invalid after this call.
+ * for reuse. The pointer becomes invalid after this call. The block metadata
+ * lives in a header right before the payload, so this is O(1) regardless of
+ * how many allocations are alive.
+ *
+ * **For FRAME, STACK and VIRTUAL allocators:** This is a no-op, like LINEAR. Memory is reclaimed
+ * by tl_memory_allocator_reset() or tl_memory_stack_pop_to_marker().
+ *
+ * **For SLAB allocators:** The object is pushed back onto the free list of its
+ * size class and reused by the next allocation of that class.
  *
  * @param allocator Allocator that owns the memory
  * @param pointer Pointer to free (may be NULL)
@@ -224,6 +384,229 @@ void* tl_memory_alloc(TLAllocator* allocator, TLMemoryTag tag, u32 size);
  */
 void tl_memory_free(TLAllocator* allocator, void* pointer);
 
+/**
+ * @brief Reclaim every allocation of an allocator at once
+ *
+ * **For FRAME allocators:** Switches to the other buffer and rewinds it in O(1).
+ * Allocations made since the previous reset stay valid until the next one, so
+ * data produced in frame N can still be read during frame N+1.
+ *
+ * **For LINEAR allocators:** Rewinds every page, keeping them for reuse.
+ *
+ * **For STACK allocators:** Rewinds to the very first byte, keeping every chunk.
+ *
+ * **For VIRTUAL allocators:** Rewinds to the base, keeping the committed pages.
+ *
+ * @param allocator Allocator to reset (must not be NULL)
+ *
+ * @note Fatal for allocator types that do not support reset.
+ *
+ * @see tl_memory_frame_allocated
+ * @see tl_memory_frame_peak
+ *
+ * @code
+ * // Once per frame, before anything allocates from it
+ * tl_memory_allocator_reset(global->frame_allocator);
+ * Vertex* scratch = tl_memory_alloc(global->frame_allocator, TL_MEMORY_GRAPHICS, sizeof(Vertex) * 64);
+ * @endcode
+ */
+void tl_memory_allocator_reset(TLAllocator* allocator);
+
+/**
+ * @brief Capture the current top of a STACK allocator
+ *
+ * @param allocator STACK allocator (must not be NULL)
+ * @return Marker to pass to tl_memory_stack_pop_to_marker()
+ *
+ * @see tl_memory_stack_pop_to_marker
+ * @see tl_memory_scratch
+ */
+TLMemoryMarker tl_memory_stack_push_marker(TLAllocator* allocator);
+
+/**
+ * @brief Release everything allocated after a marker
+ *
+ * Rewinds the allocator in O(1). Markers must be popped in reverse order of
+ * their push; popping an outer marker invalidates the inner ones.
+ *
+ * @param allocator STACK allocator the marker was taken from
+ * @param marker Marker returned by tl_memory_stack_push_marker()
+ *
+ * @code
+ * TLAllocator* scratch = tl_memory_scratch();
+ * const TLMemoryMarker marker = tl_memory_stack_push_marker(scratch);
+ *
+ * TLStringBuilder* builder = tl_string_builder_create(scratch, 128);
+ * // ... temporary work ...
+ *
+ * tl_memory_stack_pop_to_marker(scratch, marker);
+ * @endcode
+ */
+void tl_memory_stack_pop_to_marker(TLAllocator* allocator, TLMemoryMarker marker);
+
+/**
+ * @brief Thread-local STACK allocator for temporary scopes
+ *
+ * Created on first use in each thread and kept until the thread ends. Always
+ * bracket its use with tl_memory_stack_push_marker() and
+ * tl_memory_stack_pop_to_marker() so nested callers can share it.
+ *
+ * @return The calling thread's scratch allocator
+ *
+ * @see tl_memory_scratch_release
+ */
+TLAllocator* tl_memory_scratch(void);
+
+/**
+ * @brief Destroy the calling thread's scratch allocator
+ *
+ * @note Called by the thread wrapper when a TLThread function returns and by
+ *       tl_memory_terminate() for the main thread.
+ */
+void tl_memory_scratch_release(void);
+
+/**
+ * @brief Hand the calling thread's SHARED magazines back to their depots
+ *
+ * The cached free objects become available to the other threads instead of
+ * staying with a thread that is about to end.
+ *
+ * @note Called by the thread wrapper when a TLThread function returns.
+ */
+void tl_memory_cache_release(void);
+
+/**
+ * @brief Back future commits of a VIRTUAL allocator with huge pages
+ *
+ * Commits switch to 2 MiB steps and are advised with MADV_HUGEPAGE on Linux.
+ * Best effort: ignored where transparent huge pages are unavailable.
+ *
+ * @param allocator VIRTUAL allocator (must not be NULL)
+ * @param enabled true to request huge pages
+ *
+ * @code
+ * TLAllocator* world = tl_memory_allocator_create(TL_GIBI_BYTES(1), TL_ALLOCATOR_VIRTUAL);
+ * tl_memory_virtual_set_huge_pages(world, true);
+ * @endcode
+ */
+void tl_memory_virtual_set_huge_pages(TLAllocator* allocator, b8 enabled);
+
+/**
+ * @brief Bytes allocated from a FRAME allocator since its last reset
+ *
+ * @param allocator FRAME allocator to query (must not be NULL)
+ * @return Bytes used in the current frame buffer, including alignment padding
+ *
+ * @see tl_memory_frame_peak
+ */
+u32 tl_memory_frame_allocated(const TLAllocator* allocator);
+
+/**
+ * @brief Highest per-frame usage of a FRAME allocator
+ *
+ * Use it to size teleios.memory.frame.kibibytes in application.yml.
+ *
+ * @param allocator FRAME allocator to query (must not be NULL)
+ * @return Largest number of bytes allocated within a single frame
+ *
+ * @see tl_memory_frame_allocated
+ */
+u32 tl_memory_frame_peak(const TLAllocator* allocator);
+
+/**
+ * @brief Telemetry for every allocation made with a tag
+ *
+ * Counts across all allocators and threads. SLAB allocations are accounted
+ * with their size class. Bytes from STACK allocators are released by markers
+ * and only show up in the allocator's own counters; their allocations are
+ * still counted here.
+ *
+ * @param tag Tag to query
+ * @return Counter snapshot
+ *
+ * @see tl_memory_stats_dump
+ */
+TLMemoryStats tl_memory_stats_tag(TLMemoryTag tag);
+
+/**
+ * @brief Telemetry for a single allocator
+ *
+ * @param allocator Allocator to query (must not be NULL)
+ * @return Counter snapshot
+ */
+TLMemoryStats tl_memory_stats_allocator(const TLAllocator* allocator);
+
+/**
+ * @brief Close the running frame for the per-frame allocation counts
+ *
+ * Called once per iteration by tl_application_run().
+ */
+void tl_memory_stats_frame(void);
+
+/**
+ * @brief Log every tag and allocator with allocations at DEBUG level
+ *
+ * Called by tl_application_run() every teleios.memory.telemetry.seconds
+ * seconds (0 or missing disables it).
+ */
+void tl_memory_stats_dump(void);
+
+/**
+ * @brief Cap the live bytes of a tag across every allocator
+ *
+ * Checked against the tl_memory_stats_tag() counters on every allocation.
+ * Crossing the soft threshold submits TL_EVENT_MEMORY_PRESSURE once, so
+ * subscribers can release caches; it is submitted again after usage dropped
+ * back below the threshold and crosses it anew. Going past the limit submits
+ * the event on every allocation and aborts with TLFATAL if the handlers did
+ * not bring usage back under it.
+ *
+ * @param tag Tag to cap
+ * @param limit Hard limit in bytes, 0 removes the budget
+ * @param soft_percent Soft threshold in percent of the limit, 0 for the default (80)
+ *
+ * @note Handlers run on the allocating thread, from inside the allocation
+ * @note STACK allocations never count against tag budgets (see tl_memory_stats_tag)
+ *
+ * @see tl_memory_budget_configure
+ */
+void tl_memory_budget_tag(TLMemoryTag tag, u64 limit, u8 soft_percent);
+
+/**
+ * @brief Cap the live bytes of a single allocator
+ *
+ * Same behavior as tl_memory_budget_tag(), checked against the
+ * tl_memory_stats_allocator() counters.
+ *
+ * @param allocator Allocator to cap (must not be NULL)
+ * @param limit Hard limit in bytes, 0 removes the budget
+ * @param soft_percent Soft threshold in percent of the limit, 0 for the default (80)
+ */
+void tl_memory_budget_allocator(TLAllocator* allocator, u64 limit, u8 soft_percent);
+
+/**
+ * @brief Apply the budgets declared in the application config
+ *
+ * Called by tl_platform_initialize() once the config is loaded. Tags are named
+ * after their TLMemoryTag in lower case without the TL_MEMORY_ prefix:
+ *
+ * @code
+ * teleios:
+ *   memory:
+ *     budget:
+ *       tag:
+ *         scene:
+ *           mebibytes: 256
+ *           soft: 75          # percent, optional
+ *         string:
+ *           mebibytes: 16
+ *       allocator:
+ *         global:             # global->allocator
+ *           mebibytes: 512
+ * @endcode
+ */
+void tl_memory_budget_configure(void);
+
 /**
  * @brief Fill memory with a repeated byte value
  *
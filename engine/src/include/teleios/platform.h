@@ -44,4 +44,63 @@ b8 tl_platform_initialize(void);
  */
 b8 tl_platform_terminate(void);
 
+/**
+ * @brief Reserve a range of address space without backing memory
+ *
+ * Linux uses mmap(PROT_NONE), Windows uses VirtualAlloc(MEM_RESERVE).
+ * Nothing can be read or written until tl_platform_memory_commit().
+ *
+ * @param size Bytes to reserve (rounded up to whole pages by the OS)
+ * @return Base address of the range, or NULL on failure
+ *
+ * @see tl_platform_memory_commit
+ * @see tl_platform_memory_release
+ */
+void* tl_platform_memory_reserve(u64 size);
+
+/**
+ * @brief Back part of a reserved range with read/write memory
+ *
+ * @param address Page aligned address inside a reserved range
+ * @param size Bytes to commit, multiple of the page size
+ * @param huge_pages Request transparent huge pages (MADV_HUGEPAGE on Linux,
+ *        ignored on Windows)
+ * @return true on success, false on failure
+ */
+b8 tl_platform_memory_commit(void* address, u64 size, b8 huge_pages);
+
+/**
+ * @brief Return a whole reserved range to the OS
+ *
+ * @param address Base address returned by tl_platform_memory_reserve()
+ * @param size Size passed to tl_platform_memory_reserve()
+ */
+void tl_platform_memory_release(void* address, u64 size);
+
+/**
+ * @brief Create a file of `size` bytes and map it for writing
+ *
+ * Any existing file is truncated. Linux preallocates the blocks with
+ * posix_fallocate() and maps them MAP_SHARED, Windows uses a file mapping
+ * view. Stores through the mapping reach the file without a syscall.
+ *
+ * @param path File to create
+ * @param size Bytes to preallocate and map
+ * @param handle Receives the OS handle tl_platform_file_unmap() needs
+ * @return Base address of the mapping, or NULL on failure
+ *
+ * @see tl_platform_file_unmap
+ */
+void* tl_platform_file_map(const char* path, u64 size, void** handle);
+
+/**
+ * @brief Unmap a file mapped by tl_platform_file_map() and cut it to `used` bytes
+ *
+ * @param address Base address returned by tl_platform_file_map()
+ * @param size Size passed to tl_platform_file_map()
+ * @param used Bytes written, the preallocated tail is dropped
+ * @param handle Handle returned by tl_platform_file_map()
+ */
+void tl_platform_file_unmap(void* address, u64 size, u64 used, void* handle);
+
 #endif
@@ -6,6 +6,10 @@
 
 /**
  * @brief Push new function frame to call stack and log entry
+ *
+ * The arguments are not formatted here: the frame keeps the format and up to
+ * TL_PROFILER_FRAME_ARGUMENTS_MAXIMUM raw words, turned into text only by a
+ * snapshot that keeps arguments.
  */
 void tl_profiler_frame_push(const char* filename, u32 lineno, const char* function, const char* arguments, ...) ;
 
@@ -26,6 +30,296 @@ void tl_profiler_stacktrace_snapshot(TLStackTrace* trace);
  */
 void tl_profiler_stacktrace_print(const TLStackTrace* trace);
 
+/**
+ * @brief Keep frame arguments in captured stack traces
+ *
+ * Off by default: snapshots record the call sites only, and identical stacks
+ * are stored once. When enabled the arguments of every frame are formatted
+ * at snapshot time and copied as well, which makes stacks with different
+ * arguments distinct. Strings passed as "%s" are read then, not at push time.
+ *
+ * @param enabled true to keep arguments in the snapshots taken from now on
+ */
+void tl_profiler_stacktrace_keep_arguments(b8 enabled);
+
+/**
+ * @brief Number of distinct stack traces captured so far
+ */
+u32 tl_profiler_stacktrace_count(void);
+
+/**
+ * @brief Release every interned stack trace
+ *
+ * Traces captured earlier can no longer be printed. Called by
+ * tl_platform_terminate() once nothing is left to report.
+ */
+void tl_profiler_stacktrace_release(void);
+
+// ---------------------------------
+// Timed zones
+// ---------------------------------
+
+typedef enum {
+    TL_PROFILER_EVENT_ZONE,             ///< A completed zone, from begin to end
+    TL_PROFILER_EVENT_INSTANT,          ///< A point in time carrying a value, begin == end
+    TL_PROFILER_EVENT_COUNTER,          ///< A sample of a named counter, begin == end
+} TLProfilerEventType;
+
+/**
+ * @brief Static description of a timed zone or a counter
+ *
+ * Declared by TL_PROFILER_ZONE_BEGIN() or TL_PROFILER_COUNTER() at the call
+ * site, so recording only stores its address, the timestamps and the value.
+ */
+typedef struct {
+    const char* name;
+    const char* filename;
+    const char* function;
+    u32 lineno;
+    TLProfilerEventType type;
+} TLProfilerZone;
+
+/**
+ * @brief One recorded event, as returned by tl_profiler_zones_collect()
+ */
+typedef struct {
+    const TLProfilerZone* zone;
+    TLProfilerEventType type;
+    u64 thread;             ///< tl_thread_current_id() of the recording thread
+    u64 begin;              ///< Nanoseconds since the zones were first enabled
+    u64 end;                ///< Nanoseconds since the zones were first enabled
+    u64 value;              ///< Frame number of frame marks, sample of counters as an i64, 0 for zones
+} TLProfilerZoneEvent;
+
+/**
+ * @brief Start recording timed zones
+ *
+ * Zones are compiled in every build type (see TELEIOS_PROFILER_ZONES) but
+ * record nothing until enabled. tl_platform_initialize() applies
+ * teleios.profiler.zones.enabled from the application config.
+ *
+ * @param enabled true to record the zones entered from now on
+ */
+void tl_profiler_zones_enable(b8 enabled);
+
+/**
+ * @brief Whether timed zones are being recorded
+ */
+b8 tl_profiler_zones_enabled(void);
+
+/**
+ * @brief Timestamp for TL_PROFILER_ZONE_BEGIN(), 0 while zones are disabled
+ */
+u64 tl_profiler_zone_begin(void);
+
+/**
+ * @brief Record a zone in the calling thread's ring buffer
+ *
+ * @param zone Static zone descriptor
+ * @param begin Value returned by tl_profiler_zone_begin(), nothing is recorded when 0
+ */
+void tl_profiler_zone_end(const TLProfilerZone* zone, u64 begin);
+
+/**
+ * @brief Record a frame boundary as an instant event
+ *
+ * Called by the graphics thread after every buffer swap with
+ * global->frame_count.
+ *
+ * @param frame Number of the frame that just ended
+ */
+void tl_profiler_frame_mark(u64 frame);
+
+/**
+ * @brief Record a sample of a counter in the calling thread's ring buffer
+ *
+ * Use TL_PROFILER_COUNTER() rather than calling this directly. Counters are
+ * recorded only while zones are enabled, become counter ("C") tracks in the
+ * trace and get last/min/max lines in tl_profiler_zones_dump().
+ *
+ * @param counter Static counter descriptor
+ * @param value Sample
+ */
+void tl_profiler_counter(const TLProfilerZone* counter, i64 value);
+
+/**
+ * @brief Name the calling thread in exported traces
+ *
+ * @param name Thread name, truncated to 31 characters
+ */
+void tl_profiler_thread_name(const char* name);
+
+/**
+ * @brief Move the recorded zones of every thread out of their ring buffers
+ *
+ * Each thread keeps the last TL_PROFILER_ZONE_RING_SIZE zones it recorded;
+ * older ones not collected in time are dropped and counted as lost.
+ *
+ * @note Events collected here no longer reach tl_profiler_zones_dump() or an
+ *       open trace, use it only when neither is in use
+ *
+ * @param events Output array
+ * @param capacity Size of the output array, zones that do not fit stay for the next call
+ * @return Number of zones written to events
+ *
+ * @note Safe to call while other threads keep recording
+ */
+u32 tl_profiler_zones_collect(TLProfilerZoneEvent* events, u32 capacity);
+
+/**
+ * @brief Log calls, total, average and maximum time of every zone recorded since the last collection
+ *
+ * Counters get their last, minimum and maximum sample over the same span.
+ *
+ * Logged at INFO so it is available in release builds. Called by
+ * tl_application_run() every teleios.profiler.zones.seconds seconds.
+ */
+void tl_profiler_zones_dump(void);
+
+/**
+ * @brief Start streaming every recorded event to a Chrome Trace Event file
+ *
+ * The file uses the JSON array format, readable by chrome://tracing and
+ * ui.perfetto.dev even when the process dies before tl_profiler_trace_end().
+ * Zones become complete ("X") events, frame marks global instant ("i") events,
+ * and named threads get thread_name metadata. Enables the zones.
+ * tl_platform_initialize() starts one when teleios.profiler.trace.path is set.
+ *
+ * @param path File to create, replaced if it exists
+ * @return false if a trace is already open or the file cannot be created
+ */
+b8 tl_profiler_trace_begin(const char* path);
+
+/**
+ * @brief Write the events recorded so far to the open trace
+ *
+ * Called by tl_application_run() once per frame so the ring buffers never
+ * overflow. Does nothing when no trace is open.
+ */
+void tl_profiler_trace_flush(void);
+
+/**
+ * @brief Flush, name the threads and close the open trace
+ *
+ * Called by tl_platform_terminate(). Does nothing when no trace is open.
+ */
+void tl_profiler_trace_end(void);
+
+/**
+ * @brief Release the ring buffers of every thread
+ *
+ * Called by tl_platform_terminate() once the other threads are joined.
+ */
+void tl_profiler_zones_release(void);
+
+// ---------------------------------
+// Frame statistics
+// ---------------------------------
+
+/**
+ * @brief Phases of the tl_application_run() loop
+ */
+typedef enum {
+    TL_PROFILER_PHASE_FRAME,            ///< The whole iteration
+    TL_PROFILER_PHASE_FRAME_BEGIN,      ///< tl_scene_frame_begin()
+    TL_PROFILER_PHASE_STEP,             ///< Every tl_scene_step() of the iteration, only when at least one ran
+    TL_PROFILER_PHASE_UPDATE,           ///< tl_scene_update()
+    TL_PROFILER_PHASE_FRAME_END,        ///< tl_scene_frame_end()
+    TL_PROFILER_PHASE_INPUT,            ///< tl_input_update()
+    TL_PROFILER_PHASE_EVENTS,           ///< glfwPollEvents()
+    TL_PROFILER_PHASE_MAXIMUM
+} TLProfilerPhase;
+
+/**
+ * @brief Percentiles of one phase over the current window, in nanoseconds
+ *
+ * Percentiles are read from a log-linear histogram and are within about 6%
+ * of the exact value, never below it. The maximum is exact.
+ */
+typedef struct {
+    u64 samples;
+    u64 p50;
+    u64 p95;
+    u64 p99;
+    u64 maximum;
+} TLProfilerPhaseStats;
+
+/**
+ * @brief Name of a phase, as used in the log line
+ */
+const char* tl_profiler_phase_name(TLProfilerPhase phase);
+
+/**
+ * @brief Add one sample to the histogram of a phase
+ *
+ * @note Main thread only, like the loop that records the phases
+ *
+ * @param phase Phase the sample belongs to
+ * @param nanos Time spent in the phase
+ */
+void tl_profiler_phase_record(TLProfilerPhase phase, u64 nanos);
+
+/**
+ * @brief Percentiles of a phase since the window was last reset
+ *
+ * @param phase Phase to read
+ * @param stats Output, zeroed when the phase has no sample
+ */
+void tl_profiler_phase_stats(TLProfilerPhase phase, TLProfilerPhaseStats* stats);
+
+/**
+ * @brief Drop every sample, starting a new window
+ */
+void tl_profiler_phase_reset(void);
+
+/**
+ * @brief Log p50/p95/p99/max of every phase in one line and start a new window
+ *
+ * Logged at INFO so it is available in release builds. Called by
+ * tl_application_run() every teleios.profiler.frames.seconds seconds.
+ */
+void tl_profiler_phase_dump(void);
+
+#if ! defined(TELEIOS_PROFILER_ZONES)
+#   define TELEIOS_PROFILER_ZONES 1
+#endif
+
+/**
+ * @brief Time a block of code, in any build type
+ *
+ * @code
+ * TL_PROFILER_ZONE_BEGIN(update, "scene_update")
+ * tl_scene_update(delta_time);
+ * TL_PROFILER_ZONE_END(update)
+ * @endcode
+ */
+#if TELEIOS_PROFILER_ZONES
+#   define TL_PROFILER_ZONE_BEGIN(variable, label) \
+        static const TLProfilerZone variable##_zone = { label, __FILE__, __func__, __LINE__, TL_PROFILER_EVENT_ZONE }; \
+        const u64 variable = tl_profiler_zone_begin();
+#   define TL_PROFILER_ZONE_END(variable) tl_profiler_zone_end(&variable##_zone, variable);
+#else
+#   define TL_PROFILER_ZONE_BEGIN(variable, label)
+#   define TL_PROFILER_ZONE_END(variable)
+#endif
+
+/**
+ * @brief Sample a counter, in any build type
+ *
+ * The value is only evaluated while zones are enabled.
+ *
+ * @code
+ * TL_PROFILER_COUNTER("graphics_queue", tl_queue_size(m_queue))
+ * @endcode
+ */
+#if TELEIOS_PROFILER_ZONES
+#   define TL_PROFILER_COUNTER(label, value) { \
+        static const TLProfilerZone tl_profiler_counter_zone = { label, __FILE__, __func__, __LINE__, TL_PROFILER_EVENT_COUNTER }; \
+        if (tl_profiler_zones_enabled()) tl_profiler_counter(&tl_profiler_counter_zone, (i64)(value)); }
+#else
+#   define TL_PROFILER_COUNTER(label, value)
+#endif
+
 #if defined(TELEIOS_BUILD_DEBUG)
 #   define TL_PROFILER_PUSH { tl_profiler_frame_push(__FILE__, __LINE__, __func__, NULL); }
 #   define TL_PROFILER_PUSH_WITH(args, ...) { tl_profiler_frame_push(__FILE__, __LINE__, __func__, args, ##__VA_ARGS__); }
@@ -3,6 +3,24 @@
 
 #include "teleios/defines.h"
 
+/**
+ * @brief Lock contention switch
+ *
+ * When 1, every TLMutex feeds the statistics of its name: acquisitions,
+ * contended acquisitions, wait and hold times. Locking then costs a trylock
+ * and a clock read more. When 0, names are ignored and no statistics are kept.
+ *
+ * Defaults to 1 in debug builds and 0 otherwise. Override with
+ * -DTELEIOS_THREAD_CONTENTION=ON|OFF (CMake cache variable of the same name).
+ */
+#if ! defined(TELEIOS_THREAD_CONTENTION)
+#   if defined(TELEIOS_BUILD_DEBUG)
+#       define TELEIOS_THREAD_CONTENTION 1
+#   else
+#       define TELEIOS_THREAD_CONTENTION 0
+#   endif
+#endif
+
 /**
  * Thread function signature
  * @param arg User-provided argument passed to the thread
@@ -62,9 +80,11 @@ void tl_thread_sleep(u32 milliseconds);
 
 /**
  * Creates a new mutex
+ * @param allocator Allocator
+ * @param name Statistics name, mutexes sharing a name share their statistics (truncated to 31 characters)
  * @return Pointer to TLMutex on success, NULL on failure
  */
-TLMutex* tl_mutex_create(TLAllocator* allocator);
+TLMutex* tl_mutex_create(TLAllocator* allocator, const char* name);
 
 /**
  * Destroys a mutex and frees its resources
@@ -93,6 +113,41 @@ b8 tl_mutex_trylock(TLMutex* mutex);
  */
 b8 tl_mutex_unlock(TLMutex* mutex);
 
+/**
+ * Lock statistics of every mutex created with one name, times in nanoseconds
+ */
+typedef struct {
+    u64 acquisitions;
+    u64 contended;          ///< Acquisitions that had to wait, the trylock failed first
+    u64 wait_total;
+    u64 wait_maximum;
+    u64 hold_total;         ///< Time between lock and unlock, condition waits excluded
+    u64 hold_maximum;
+} TLMutexStats;
+
+/**
+ * Reads the lock statistics of a name
+ * @param name Name given to tl_mutex_create()
+ * @param stats Output, zeroed when nothing is known about the name
+ * @return b8 false without TELEIOS_THREAD_CONTENTION or for an unknown name
+ */
+b8 tl_mutex_stats(const char* name, TLMutexStats* stats);
+
+/**
+ * Logs the lock statistics of every name, most contended first
+ *
+ * Called by tl_platform_terminate(). Logs nothing without TELEIOS_THREAD_CONTENTION.
+ */
+void tl_mutex_stats_dump(void);
+
+/**
+ * Records the contended acquisitions and the wait time of every name as profiler counters
+ *
+ * Both are running totals, named "mutex.<name>.contended" and
+ * "mutex.<name>.wait_us". Called by tl_application_run() once per second.
+ */
+void tl_mutex_stats_sample(void);
+
 // ---------------------------------
 // Condition Variables
 // ---------------------------------
@@ -3,9 +3,17 @@
 #include <GLFW/glfw3.h>
 
 #define FRAME_CAP 250000.0
+#define FRAME_ARENA_DEFAULT_KIBIBYTES 1024
 
 #include "teleios/application/event.inl"
 
+// Records the time since `since` for the phase, returns the new mark
+static u64 tl_application_phase(const TLProfilerPhase phase, const u64 since) {
+    const u64 now = tl_time_monotonic_nanos();
+    tl_profiler_phase_record(phase, now - since);
+    return now;
+}
+
 b8 tl_application_initialize(void) {
     TL_PROFILER_PUSH
 
@@ -13,6 +21,10 @@ b8 tl_application_initialize(void) {
     tl_event_subscribe(TL_EVENT_WINDOW_RESTORED, tl_application_handle_window_restored);
     tl_event_subscribe(TL_EVENT_WINDOW_MINIMIZED, tl_application_handle_window_minimized);
 
+    u32 frame_kibibytes = tl_config_get_u32("teleios.memory.frame.kibibytes");
+    if (frame_kibibytes == 0) frame_kibibytes = FRAME_ARENA_DEFAULT_KIBIBYTES;
+    global->frame_allocator = tl_memory_allocator_create(TL_KIBI_BYTES(frame_kibibytes), TL_ALLOCATOR_FRAME);
+
     if (!tl_scene_initialize()) {
         TL_PROFILER_POP_WITH(false)
     }
@@ -42,37 +54,71 @@ b8 tl_application_run(void) {
     u64 last_time = tl_time_epoch_micros();
     u64 last_frame_count = 0;
     u64 last_update_count = 0;
+    u32 telemetry_seconds = 0;
+    const u32 telemetry_interval = tl_config_get_u32("teleios.memory.telemetry.seconds");
+    u32 zones_seconds = 0;
+    const u32 zones_interval = tl_config_get_u32("teleios.profiler.zones.seconds");
+    u32 frames_seconds = 0;
+    const u32 frames_interval = tl_config_get_u32("teleios.profiler.frames.seconds");
 
     TLDEBUG("Entering Simulation loop")
     glfwShowWindow(tl_window_handler());
     for ( ; global->running ; ) {
+        TL_PROFILER_ZONE_BEGIN(frame, "frame")
+        const u64 frame_start = tl_time_monotonic_nanos();
         const u64 new_time = tl_time_epoch_micros();
         f64 delta_time = (f64)(new_time - last_time);
         last_time = new_time;
 
+        TL_PROFILER_COUNTER("frame_bytes", tl_memory_frame_allocated(global->frame_allocator))
+        tl_memory_allocator_reset(global->frame_allocator);
+        tl_memory_stats_frame();
+
+        u64 phase = tl_time_monotonic_nanos();
+        TL_PROFILER_ZONE_BEGIN(frame_begin, "frame_begin")
         tl_scene_frame_begin();
+        TL_PROFILER_ZONE_END(frame_begin)
+        phase = tl_application_phase(TL_PROFILER_PHASE_FRAME_BEGIN, phase);
 
         if (!global->suspended) {
             global->update_count++;
 
             // Cap frame time to prevent spiral of death
             if (delta_time > FRAME_CAP) {
-                TLWARN("Frame time %.2f ms exceeded, capping to %.2f ms",  delta_time / 1000.0, FRAME_CAP / 1000.0);
+                TLWARN_LIMITED("Frame time %.2f ms exceeded, capping to %.2f ms",  delta_time / 1000.0, FRAME_CAP / 1000.0);
                 delta_time = FRAME_CAP;
             }
 
             accumulator += delta_time;
-            while (accumulator >= STEP) {
-                tl_scene_step(STEP);
-                accumulator -= STEP;
+            if (accumulator >= STEP) {
+                while (accumulator >= STEP) {
+                    TL_PROFILER_ZONE_BEGIN(step, "step")
+                    tl_scene_step(STEP);
+                    TL_PROFILER_ZONE_END(step)
+                    accumulator -= STEP;
+                }
+                phase = tl_application_phase(TL_PROFILER_PHASE_STEP, phase);
             }
 
+            TL_PROFILER_ZONE_BEGIN(update, "update")
             tl_scene_update(delta_time);
+            TL_PROFILER_ZONE_END(update)
+            phase = tl_application_phase(TL_PROFILER_PHASE_UPDATE, phase);
         }
 
+        TL_PROFILER_ZONE_BEGIN(frame_end, "frame_end")
         tl_scene_frame_end();
+        TL_PROFILER_ZONE_END(frame_end)
+        phase = tl_application_phase(TL_PROFILER_PHASE_FRAME_END, phase);
+
+        TL_PROFILER_ZONE_BEGIN(input, "input")
         tl_input_update();
+        phase = tl_application_phase(TL_PROFILER_PHASE_INPUT, phase);
         glfwPollEvents();
+        TL_PROFILER_ZONE_END(input)
+        phase = tl_application_phase(TL_PROFILER_PHASE_EVENTS, phase);
+        TL_PROFILER_ZONE_END(frame)
+        tl_profiler_phase_record(TL_PROFILER_PHASE_FRAME, phase - frame_start);
 
         fps_timer += delta_time;
         if (fps_timer >= TL_CHRONO_ONE_SECOND_IN_MICROS) {
@@ -89,7 +135,26 @@ b8 tl_application_run(void) {
             last_frame_count = global->frame_count;
             last_update_count = global->update_count;
             fps_timer -= TL_CHRONO_ONE_SECOND_IN_MICROS;
+
+            if (telemetry_interval > 0 && ++telemetry_seconds >= telemetry_interval) {
+                tl_memory_stats_dump();
+                telemetry_seconds = 0;
+            }
+
+            if (zones_interval > 0 && tl_profiler_zones_enabled() && ++zones_seconds >= zones_interval) {
+                tl_profiler_zones_dump();
+                zones_seconds = 0;
+            }
+
+            tl_mutex_stats_sample();
+
+            if (frames_interval > 0 && ++frames_seconds >= frames_interval) {
+                tl_profiler_phase_dump();
+                frames_seconds = 0;
+            }
         }
+
+        tl_profiler_trace_flush();
     }
     TLDEBUG("Exiting Simulation loop")
 
@@ -104,5 +169,10 @@ b8 tl_application_terminate(void) {
         TL_PROFILER_POP_WITH(false)
     }
 
+    if (global->frame_allocator != NULL) {
+        tl_memory_allocator_destroy(global->frame_allocator);
+        global->frame_allocator = NULL;
+    }
+
     TL_PROFILER_POP_WITH(true)
 }
\ No newline at end of file
@@ -72,7 +72,7 @@ static void tl_serializer_walk() {
                 }
 
                 // Create tuple for sequence indexing
-                TLTuple *tuple = tl_memory_alloc(allocator, TL_MEMORY_SERIALIZER, sizeof(TLTuple));
+                TLTuple *tuple = tl_memory_alloc_zeroed(allocator, TL_MEMORY_SERIALIZER, sizeof(TLTuple));
                 tuple->sequence = 0;
 
                 // OPTIMIZATION #1: Build tuple name using cached iterator with resync
@@ -24,7 +24,7 @@ TLArray* tl_array_create(TLAllocator* allocator, u32 initial_capacity, const b8
         initial_capacity = 8;
     }
 
-    TLArray* array = tl_memory_alloc(allocator, TL_MEMORY_CONTAINER_ARRAY, sizeof(TLArray));
+    TLArray* array = tl_memory_alloc_zeroed(allocator, TL_MEMORY_CONTAINER_ARRAY, sizeof(TLArray));
     if (array == NULL) {
         TLERROR("Failed to allocate TLArray structure");
         TL_PROFILER_POP_WITH(NULL)
@@ -46,7 +46,7 @@ TLArray* tl_array_create(TLAllocator* allocator, u32 initial_capacity, const b8
 
     // Initialize thread-safety primitives
     if (thread_safe) {
-        array->mutex = tl_mutex_create(allocator);
+        array->mutex = tl_mutex_create(allocator, "array");
         if (array->mutex == NULL) {
             TLERROR("Failed to create array mutex");
             tl_memory_free(allocator, array->items);
@@ -93,10 +93,10 @@ TLIterator* tl_array_iterator(TLArray* array) {
     if (array->thread_safe) tl_mutex_lock(array->mutex);
 
     // Allocate iterator on array's allocator
-    TLIterator* iterator = tl_memory_alloc(array->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLIterator));
+    TLIterator* iterator = tl_memory_alloc_zeroed(array->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLIterator));
 
     // Allocate state on array's allocator
-    TLArrayIteratorState* state = tl_memory_alloc(array->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLArrayIteratorState));
+    TLArrayIteratorState* state = tl_memory_alloc_zeroed(array->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLArrayIteratorState));
 
     // Initialize state
     state->current_index = 0;
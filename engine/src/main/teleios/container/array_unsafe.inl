@@ -6,26 +6,21 @@
 
 static void tl_array_try_resize(TLArray* array) {
     TL_PROFILER_PUSH_WITH("0x%p", array)
+    if (array->count < array->capacity) TL_PROFILER_POP
+
     const u32 required_capacity = (u32)((f32)array->capacity * 1.75f) + 1;
     if (required_capacity <= array->capacity) TL_PROFILER_POP
 
     TLDEBUG("Resizing array from %u to %u capacity", array->capacity, required_capacity);
 
-    // Reallocate items array
-    void** new_items = tl_memory_alloc(array->allocator, TL_MEMORY_CONTAINER_ARRAY, sizeof(void*) * required_capacity);
+    // Grow in place when the allocator can, copy otherwise
+    void** new_items = tl_memory_realloc(array->allocator, TL_MEMORY_CONTAINER_ARRAY, array->items,
+        sizeof(void*) * array->capacity, sizeof(void*) * required_capacity);
     if (new_items == NULL) {
         TLERROR("Failed to reallocate array items");
         TL_PROFILER_POP
     }
 
-    // Copy existing pointers
-    if (array->count > 0) {
-        tl_memory_copy(new_items, array->items, sizeof(void*) * array->count);
-    }
-
-    // Free old memory
-    tl_memory_free(array->allocator, array->items);
-
     array->items = new_items;
     array->capacity = required_capacity;
 
@@ -20,7 +20,7 @@ TLList* tl_list_create(TLAllocator* allocator, const b8 thread_safe) {
         TL_PROFILER_POP_WITH(NULL)
     }
 
-    TLList* list = tl_memory_alloc(allocator, TL_MEMORY_CONTAINER_LIST, sizeof(TLList));
+    TLList* list = tl_memory_alloc_zeroed(allocator, TL_MEMORY_CONTAINER_LIST, sizeof(TLList));
     if (list == NULL) {
         TLERROR("Failed to allocate TLList structure")
         TL_PROFILER_POP_WITH(NULL)
@@ -35,7 +35,7 @@ TLList* tl_list_create(TLAllocator* allocator, const b8 thread_safe) {
     list->mutex = NULL;
 
     if (thread_safe) {
-        list->mutex = tl_mutex_create(allocator);
+        list->mutex = tl_mutex_create(allocator, "list");
         if (!list->mutex) {
             TLERROR("Failed to create mutex for list")
             tl_memory_free(allocator, list);
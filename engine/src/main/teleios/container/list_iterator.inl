@@ -89,8 +89,8 @@ TLIterator* tl_list_iterator(TLList* list) {
 
     if (list->thread_safe) tl_mutex_lock(list->mutex);
 
-    TLIterator* iterator = tl_memory_alloc(list->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLIterator));
-    TLListIteratorState* state = tl_memory_alloc(list->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLListIteratorState));
+    TLIterator* iterator = tl_memory_alloc_zeroed(list->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLIterator));
+    TLListIteratorState* state = tl_memory_alloc_zeroed(list->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLListIteratorState));
 
     state->current_node = list->head;
 
@@ -6,7 +6,7 @@
 
 static TLListNode* tl_list_create_node(TLAllocator* allocator, void* data) {
     TL_PROFILER_PUSH_WITH("0x%p, 0x%p", allocator, data)
-    TLListNode* node = tl_memory_alloc(allocator, TL_MEMORY_CONTAINER_LIST, sizeof(TLListNode));
+    TLListNode* node = tl_memory_alloc_zeroed(allocator, TL_MEMORY_CONTAINER_LIST, sizeof(TLListNode));
     node->data = data;
     TL_PROFILER_POP_WITH(node)
 }
@@ -19,10 +19,10 @@ TLMap* tl_map_create(TLAllocator* allocator, const u32 capacity, const b8 thread
         TL_PROFILER_POP_WITH(NULL)
     }
 
-    TLMap* map = tl_memory_alloc(allocator, TL_MEMORY_CONTAINER_MAP, sizeof(TLMap));
+    TLMap* map = tl_memory_alloc_zeroed(allocator, TL_MEMORY_CONTAINER_MAP, sizeof(TLMap));
 
     const u32 actual_capacity = tl_number_next_power_of_2(capacity == 0 ? 16 : capacity);
-    map->buckets = tl_memory_alloc(allocator, TL_MEMORY_CONTAINER_MAP, sizeof(TLMapEntry*) * actual_capacity);
+    map->buckets = tl_memory_alloc_zeroed(allocator, TL_MEMORY_CONTAINER_MAP, sizeof(TLMapEntry*) * actual_capacity);
     map->capacity = actual_capacity;
     map->size = 0;
     map->mod_count = 0;
@@ -32,7 +32,7 @@ TLMap* tl_map_create(TLAllocator* allocator, const u32 capacity, const b8 thread
     map->mutex = NULL;
 
     if (thread_safe) {
-        map->mutex = tl_mutex_create(allocator);
+        map->mutex = tl_mutex_create(allocator, "map");
         if (!map->mutex) {
             TLERROR("Failed to create mutex for map")
             tl_memory_free(allocator, map->buckets);
@@ -125,8 +125,8 @@ TLIterator* tl_map_keys(TLMap* map) {
 
     if (map->thread_safe) tl_mutex_lock(map->mutex);
 
-    TLIterator* iterator = tl_memory_alloc(map->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLIterator));
-    TLMapIteratorState* state = tl_memory_alloc(map->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLMapIteratorState));
+    TLIterator* iterator = tl_memory_alloc_zeroed(map->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLIterator));
+    TLMapIteratorState* state = tl_memory_alloc_zeroed(map->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLMapIteratorState));
 
     state->bucket_index = 0;
     state->current_entry = NULL;
@@ -32,7 +32,7 @@ static u32 tl_map_hash(const TLString* key, const u32 capacity) {
 static TLMapEntry* tl_map_create_entry(TLAllocator* allocator, const TLString* key, TLList* value) {
     TL_PROFILER_PUSH_WITH("0x%p, 0x%p, 0x%p", allocator, key, value)
 
-    TLMapEntry* entry = tl_memory_alloc(allocator, TL_MEMORY_CONTAINER_MAP, sizeof(TLMapEntry));
+    TLMapEntry* entry = tl_memory_alloc_zeroed(allocator, TL_MEMORY_CONTAINER_MAP, sizeof(TLMapEntry));
     entry->key = tl_string_copy(key);
     entry->value = value;
 
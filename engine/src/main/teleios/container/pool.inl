@@ -29,9 +29,9 @@ TLObjectPool* tl_pool_create(TLAllocator* allocator, const u32 object_size, cons
         TL_PROFILER_POP_WITH(NULL)
     }
 
-    TLObjectPool* pool = tl_memory_alloc(allocator, TL_MEMORY_CONTAINER_POOL, sizeof(TLObjectPool));
-    pool->memory = tl_memory_alloc(allocator, TL_MEMORY_CONTAINER_POOL, object_size * capacity);
-    pool->in_use = tl_memory_alloc(allocator, TL_MEMORY_CONTAINER_POOL, sizeof(b8) * capacity);
+    TLObjectPool* pool = tl_memory_alloc_zeroed(allocator, TL_MEMORY_CONTAINER_POOL, sizeof(TLObjectPool));
+    pool->memory = tl_memory_alloc_zeroed(allocator, TL_MEMORY_CONTAINER_POOL, object_size * capacity);
+    pool->in_use = tl_memory_alloc_zeroed(allocator, TL_MEMORY_CONTAINER_POOL, sizeof(b8) * capacity);
     pool->object_size = object_size;
     pool->capacity = capacity;
     pool->next_free = 0;
@@ -46,7 +46,7 @@ TLObjectPool* tl_pool_create(TLAllocator* allocator, const u32 object_size, cons
     tl_memory_set(pool->in_use, 0, sizeof(b8) * capacity);
 
     if (thread_safe) {
-        pool->mutex = tl_mutex_create(allocator);
+        pool->mutex = tl_mutex_create(allocator, "pool");
         if (!pool->mutex) {
             TLERROR("Failed to create mutex for pool")
             tl_memory_free(allocator, pool->in_use);
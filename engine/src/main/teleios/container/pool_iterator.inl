@@ -107,8 +107,8 @@ TLIterator* tl_pool_iterator(TLObjectPool* pool) {
 
     if (pool->thread_safe) tl_mutex_lock(pool->mutex);
 
-    TLIterator* iterator = tl_memory_alloc(pool->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLIterator));
-    TLPoolIteratorState* state = tl_memory_alloc(pool->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLPoolIteratorState));
+    TLIterator* iterator = tl_memory_alloc_zeroed(pool->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLIterator));
+    TLPoolIteratorState* state = tl_memory_alloc_zeroed(pool->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLPoolIteratorState));
 
     state->index = 0;
 
@@ -24,13 +24,13 @@ TLQueue* tl_queue_create(TLAllocator* allocator, const u16 capacity, const b8 th
         TL_PROFILER_POP_WITH(NULL)
     }
 
-    TLQueue* queue = tl_memory_alloc(allocator, TL_MEMORY_CONTAINER_QUEUE, sizeof(TLQueue));
+    TLQueue* queue = tl_memory_alloc_zeroed(allocator, TL_MEMORY_CONTAINER_QUEUE, sizeof(TLQueue));
     if (queue == NULL) {
         TLERROR("Failed to allocate TLQueue structure")
         TL_PROFILER_POP_WITH(NULL)
     }
 
-    queue->items = tl_memory_alloc(allocator, TL_MEMORY_CONTAINER_QUEUE, sizeof(void*) * capacity);
+    queue->items = tl_memory_alloc_zeroed(allocator, TL_MEMORY_CONTAINER_QUEUE, sizeof(void*) * capacity);
     if (queue->items == NULL) {
         TLERROR("Failed to allocate queue items memory")
         tl_memory_free(allocator, queue);
@@ -42,7 +42,7 @@ TLQueue* tl_queue_create(TLAllocator* allocator, const u16 capacity, const b8 th
     queue->thread_safe = thread_safe;
 
     if (thread_safe) {
-        queue->mutex = tl_mutex_create(allocator);
+        queue->mutex = tl_mutex_create(allocator, "queue");
         queue->not_empty = tl_condition_create(allocator);
         queue->not_full = tl_condition_create(allocator);
 
@@ -92,7 +92,7 @@ void tl_queue_offer(TLQueue* queue, void* payload) {
     }
 
     if (queue->count >= queue->capacity) {
-        TLWARN("Queue is full, cannot offer payload")
+        TLWARN_LIMITED("Queue is full, cannot offer payload")
         TL_PROFILER_POP
     }
 
@@ -119,7 +119,7 @@ void tl_queue_push(TLQueue* queue, void* payload) {
 
     // Non thread-safe: just push without blocking
     if (queue->count >= queue->capacity) {
-        TLWARN("Queue is full, cannot push payload")
+        TLWARN_LIMITED("Queue is full, cannot push payload")
         TL_PROFILER_POP
     }
     tl_queue_unsafe_push(queue, payload);
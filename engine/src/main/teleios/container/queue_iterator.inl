@@ -98,8 +98,8 @@ TLIterator* tl_queue_iterator(TLQueue* queue) {
 
     if (queue->thread_safe) tl_mutex_lock(queue->mutex);
 
-    TLIterator* iterator = tl_memory_alloc(queue->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLIterator));
-    TLQueueIteratorState* state = tl_memory_alloc(queue->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLQueueIteratorState));
+    TLIterator* iterator = tl_memory_alloc_zeroed(queue->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLIterator));
+    TLQueueIteratorState* state = tl_memory_alloc_zeroed(queue->allocator, TL_MEMORY_CONTAINER_ITERATOR, sizeof(TLQueueIteratorState));
 
     state->index = queue->tail;
     state->remaining = queue->count;
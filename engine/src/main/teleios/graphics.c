@@ -53,7 +53,7 @@ b8 tl_graphics_initialize(void) {
     if (m_pool == NULL) TLFATAL("Failed to create Graphics Task Pool")
     for (u16 i = 0; i < TL_QUEUE_SIZE; ++i) {
         TLGraphicsTask* task = tl_pool_acquire(m_pool);
-        task->mutex = tl_mutex_create(global->allocator);
+        task->mutex = tl_mutex_create(global->allocator, "graphics_task");
         task->condition = tl_condition_create(global->allocator);
         tl_pool_release(m_pool, task);
     }
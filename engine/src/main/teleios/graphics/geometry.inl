@@ -31,14 +31,14 @@ void tl_graphics_geometry_bind(const TLGeometry* geometry) {
 }
 
 TLGeometry* tl_graphics_geometry_create(TLAllocator* allocator, u8 attribute_count, const TLGeometryAttribute* attributes) {
-    TLGeometry* geometry = tl_memory_alloc(allocator, TL_MEMORY_GRAPHICS, sizeof(TLGeometry));
+    TLGeometry* geometry = tl_memory_alloc_zeroed(allocator, TL_MEMORY_GRAPHICS, sizeof(TLGeometry));
     geometry->vbo_att_count = attribute_count;
     geometry->ebo_size = 0;
     geometry->vbo_size = 0;
     geometry->allocator = allocator;
 
     // Allocate and copy attributes array
-    geometry->vbo_att_nfo = tl_memory_alloc(allocator, TL_MEMORY_GRAPHICS, sizeof(TLGeometryAttribute) * attribute_count);
+    geometry->vbo_att_nfo = tl_memory_alloc_zeroed(allocator, TL_MEMORY_GRAPHICS, sizeof(TLGeometryAttribute) * attribute_count);
     for (u8 i = 0; i < attribute_count; i++) {
         geometry->vbo_att_nfo[i].type = attributes[i].type;
         // Copy string name if present
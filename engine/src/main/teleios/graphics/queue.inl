@@ -9,13 +9,17 @@ static void* tl_graphics_submit(TLGraphicsTask* task) {
     }
 
     tl_queue_push(m_queue, task);
+    TL_PROFILER_COUNTER("graphics_queue", tl_queue_size(m_queue))
+    TL_PROFILER_COUNTER("graphics_tasks", tl_pool_in_use(m_pool))
 
     if (task->wait) {
+        TL_PROFILER_ZONE_BEGIN(wait, "graphics_wait")
         tl_mutex_lock(task->mutex);
         while (!task->is_complete) {
             tl_condition_wait(task->condition, task->mutex);
         }
         tl_mutex_unlock(task->mutex);
+        TL_PROFILER_ZONE_END(wait)
 
         void* result = task->result;
         tl_pool_release(m_pool, task);
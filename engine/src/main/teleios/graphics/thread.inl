@@ -8,6 +8,7 @@
 
 static void* tl_graphics_thread(void* _) {
     (void) _;
+    tl_profiler_thread_name("graphics");
     TLDEBUG("Graphics Initializing")
     // #########################################
     // Initialize OpenGL context
@@ -36,7 +37,7 @@ static void* tl_graphics_thread(void* _) {
     for ( ; ; ) {
         TLGraphicsTask* task = NULL;
         while ((task = (TLGraphicsTask*) tl_queue_pop(m_queue)) != NULL) {
-
+            TL_PROFILER_ZONE_BEGIN(execute, "graphics_task")
             switch (task->type) {
                 case TL_RETURN_WITH_NO_ARG: {
                     task->result = task->function.rna();
@@ -54,6 +55,7 @@ static void* tl_graphics_thread(void* _) {
                     task->function.vna();
                 } break;
             }
+            TL_PROFILER_ZONE_END(execute)
 
             if (task->wait) {
                 task->is_complete = true;
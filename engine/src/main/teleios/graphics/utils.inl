@@ -22,6 +22,7 @@ void tl_graphics_clear(void) {
 static void tl_renderer_swap(void) {
     glfwSwapBuffers(tl_window_handler());
     global->frame_count++;
+    tl_profiler_frame_mark(global->frame_count);
 }
 
 void tl_graphics_update(void) {
@@ -19,32 +19,124 @@ void tl_logger_set_level(const TLLogLevel desired){
 static const char *strings[] = {"VERBOSE", "TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
 static const char *colors[] = { "\033[1;37m" , "\033[1;36m", "\033[1;34m", "\033[1;32m", "\033[1;33m", "\033[1;31m", "\033[1;31m" };
 
-void tl_logger_write(const TLLogLevel level, const char *filename, const u32 lineno, const char *message, ...) {
-    if (level < m_level) { return; }
+// The date only changes once a second: each thread keeps the text of the
+// last second it logged in and only formats the milliseconds per line, so
+// the localtime conversion (and its timezone lock) runs once a second.
+static TL_THREADLOCAL u64 m_date_second = 0;
+static TL_THREADLOCAL char m_date[32];
 
-    static TL_THREADLOCAL char output[TELEIOS_LOG_LENGTH];
-    va_list arg_ptr; va_start(arg_ptr, message);
-    vsnprintf(output, TELEIOS_LOG_LENGTH, message, arg_ptr);
-    va_end(arg_ptr);
+static const char* tl_logger_date(const u64 epoch_millis) {
+    const u64 second = epoch_millis / 1000;
+    if (second != m_date_second || m_date[0] == '\0') {
+        TLDateTime clock;
+        tl_time_local(epoch_millis, &clock);
+        snprintf(m_date, sizeof(m_date), "%d-%02d-%02d %02d:%02d:%02d",
+            clock.year, clock.month, clock.day,
+            clock.hour, clock.minute, clock.second
+        );
+        m_date_second = second;
+    }
+
+    return m_date;
+}
 
+// Formats a whole line into `buffer` in one pass, returns its length
+static u32 tl_logger_format(char* buffer, const TLLogLevel level, const u64 epoch_millis, const u64 thread, const char* filename, const u32 lineno, const char* message, va_list arguments) {
     const char* slash = strrchr(filename, '/');         // strrchr Otimizado (SIMD)
     const char* backslash = strrchr(filename, '\\');    // strrchr Otimizado (SIMD)
     const char* basename = (slash > backslash) ? slash + 1 : (backslash ? backslash + 1 : filename);
 
-    static TL_THREADLOCAL TLDateTime clock;
-    tl_time_clock(&clock);
-    
-    static TL_THREADLOCAL char buffer[TELEIOS_LOG_LENGTH];
-    const int len = snprintf(buffer, TELEIOS_LOG_LENGTH, "%s%d-%02d-%02d %02d:%02d:%02d,%06u %6llu %20s:%04d %-7s %s\n\033[1;30m",
+    static const char suffix[] = "\n\033[1;30m";
+    const u32 capacity = TELEIOS_LOG_LENGTH - (u32)sizeof(suffix);
+
+    i32 length = snprintf(buffer, capacity, "%s%s,%06u %6llu %20s:%04d %-7s ",
         colors[level],
-        clock.year, clock.month, clock.day,
-        clock.hour, clock.minute, clock.second, clock.millis,
-        tl_thread_current_id(),
-        basename, 
-        lineno, 
-        strings[level], 
-        output
+        tl_logger_date(epoch_millis),
+        (u32)(epoch_millis % 1000),
+        thread,
+        basename,
+        lineno,
+        strings[level]
     );
-    
-    if (len > 0) fwrite(buffer, 1, len, stdout);
-}
\ No newline at end of file
+    if (length < 0) return 0;
+    if ((u32)length >= capacity) length = (i32)capacity - 1;
+
+    const i32 text = vsnprintf(buffer + length, capacity - (u32)length, message, arguments);
+    if (text > 0) length += (u32)text < capacity - (u32)length ? text : (i32)(capacity - (u32)length) - 1;
+
+    memcpy(buffer + length, suffix, sizeof(suffix));
+    return (u32)length + (u32)sizeof(suffix) - 1;
+}
+
+// Same as tl_logger_format, stamped with the calling thread and the current time
+static u32 tl_logger_format_now(char* buffer, const TLLogLevel level, const char* filename, const u32 lineno, const char* message, va_list arguments) {
+    return tl_logger_format(buffer, level, tl_time_epoch_millis(), tl_thread_current_id(), filename, lineno, message, arguments);
+}
+
+#include "teleios/logger/arguments.inl"
+#include "teleios/logger/async.inl"
+#include "teleios/logger/binary.inl"
+#include "teleios/logger/file.inl"
+#include "teleios/logger/limit.inl"
+
+// Sinks receiving each level, tl_logger_set_sinks() picks them
+static u8 m_sinks[TL_LOG_LEVEL_FATAL + 1] = {
+    TL_LOG_SINK_CONSOLE | TL_LOG_SINK_FILE, TL_LOG_SINK_CONSOLE | TL_LOG_SINK_FILE,
+    TL_LOG_SINK_CONSOLE | TL_LOG_SINK_FILE, TL_LOG_SINK_CONSOLE | TL_LOG_SINK_FILE,
+    TL_LOG_SINK_CONSOLE | TL_LOG_SINK_FILE, TL_LOG_SINK_CONSOLE | TL_LOG_SINK_FILE,
+    TL_LOG_SINK_CONSOLE | TL_LOG_SINK_FILE
+};
+
+void tl_logger_set_sinks(const TLLogLevel level, const u8 sinks) {
+    m_sinks[level] = sinks;
+}
+
+u8 tl_logger_get_sinks(const TLLogLevel level) {
+    return m_sinks[level];
+}
+
+static void tl_logger_vwrite(const TLLogLevel level, const char* filename, const u32 lineno, const char* message, va_list arguments) {
+    const u8 sinks = m_sinks[level];
+    if (sinks == 0) return;
+
+    static TL_THREADLOCAL char buffer[TELEIOS_LOG_LENGTH];
+    const u32 length = tl_logger_format_now(buffer, level, filename, lineno, message, arguments);
+    if (length == 0) return;
+
+    if (sinks & TL_LOG_SINK_FILE) tl_logger_file_write(buffer, length);
+    if ((sinks & TL_LOG_SINK_CONSOLE) && !tl_logger_async_write(buffer, length)) {
+        fwrite(buffer, 1, length, stdout);
+    }
+
+    // The process is about to exit(99), nothing may stay behind and the
+    // file segment is cut to its used size instead of keeping a zero tail
+    if (level == TL_LOG_LEVEL_FATAL) {
+        tl_logger_flush();
+        tl_logger_file_end();
+    }
+}
+
+void tl_logger_write(const TLLogLevel level, const char *filename, const u32 lineno, const char *message, ...) {
+    if (level < m_level) { return; }
+
+    va_list arg_ptr; va_start(arg_ptr, message);
+    tl_logger_vwrite(level, filename, lineno, message, arg_ptr);
+    va_end(arg_ptr);
+}
+
+void tl_logger_site_write(TLLogSite* site, ...) {
+    if (site->level < m_level) { return; }
+
+    va_list arg_ptr; va_start(arg_ptr, site);
+    if (atomic_load_explicit(&m_binary, memory_order_acquire)) {
+        tl_logger_binary_write(site, arg_ptr);
+    } else {
+        tl_logger_vwrite(site->level, site->filename, site->lineno, site->format, arg_ptr);
+    }
+    va_end(arg_ptr);
+}
+
+void tl_logger_flush(void) {
+    tl_logger_async_flush();
+    tl_logger_binary_flush();
+}
@@ -0,0 +1,150 @@
+#ifndef __TELEIOS_LOGGER_ARGUMENTS__
+#define __TELEIOS_LOGGER_ARGUMENTS__
+
+#include "teleios/teleios.h"
+
+// ---------------------------------
+// Deferred printf arguments
+//
+// Arguments are captured as raw 64 bit words (integers widened, doubles by
+// their bits, strings and pointers by address) and only turned into text when
+// someone needs it. Shared by the profiler frames and the binary log.
+// ---------------------------------
+typedef enum {
+    TL_LOG_ARGUMENT_NONE,           // "%%", takes no word
+    TL_LOG_ARGUMENT_INT,
+    TL_LOG_ARGUMENT_LONG,
+    TL_LOG_ARGUMENT_LLONG,
+    TL_LOG_ARGUMENT_SIZE,
+    TL_LOG_ARGUMENT_PTRDIFF,
+    TL_LOG_ARGUMENT_DOUBLE,
+    TL_LOG_ARGUMENT_POINTER,
+    TL_LOG_ARGUMENT_STRING,         // Captured as a pointer, the binary log copies the text
+    TL_LOG_ARGUMENT_UNSUPPORTED     // "*" widths and unknown conversions end the capture
+} TLLogArgument;
+
+// Parses the conversion after a '%', returns the character past it
+static const char* tl_logger_argument_parse(const char* c, TLLogArgument* kind) {
+    while (*c == '-' || *c == '+' || *c == ' ' || *c == '#' || *c == '0') c++;
+    while (*c >= '0' && *c <= '9') c++;
+    if (*c == '.') {
+        c++;
+        while (*c >= '0' && *c <= '9') c++;
+    }
+
+    if (*c == '*') {
+        *kind = TL_LOG_ARGUMENT_UNSUPPORTED;
+        return c;
+    }
+
+    TLLogArgument length = TL_LOG_ARGUMENT_INT;
+    switch (*c) {
+        case 'h': c++; if (*c == 'h') c++; break;
+        case 'l': c++; length = TL_LOG_ARGUMENT_LONG; if (*c == 'l') { c++; length = TL_LOG_ARGUMENT_LLONG; } break;
+        case 'j': c++; length = TL_LOG_ARGUMENT_LLONG; break;
+        case 'z': c++; length = TL_LOG_ARGUMENT_SIZE; break;
+        case 't': c++; length = TL_LOG_ARGUMENT_PTRDIFF; break;
+        default: break;
+    }
+
+    switch (*c) {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+            *kind = length; break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            *kind = TL_LOG_ARGUMENT_DOUBLE; break;
+        case 'p':
+            *kind = TL_LOG_ARGUMENT_POINTER; break;
+        case 's':
+            *kind = TL_LOG_ARGUMENT_STRING; break;
+        case '%':
+            *kind = TL_LOG_ARGUMENT_NONE; break;
+        default:
+            *kind = TL_LOG_ARGUMENT_UNSUPPORTED;
+            return c;
+    }
+
+    return c + 1;
+}
+
+// Reads the next argument of `kind` as a word
+static u64 tl_logger_argument_word(const TLLogArgument kind, va_list* arguments) {
+    switch (kind) {
+        case TL_LOG_ARGUMENT_INT: return (u64)(i64)va_arg(*arguments, int);
+        case TL_LOG_ARGUMENT_LONG: return (u64)(i64)va_arg(*arguments, long);
+        case TL_LOG_ARGUMENT_LLONG: return (u64)va_arg(*arguments, long long);
+        case TL_LOG_ARGUMENT_SIZE: return (u64)va_arg(*arguments, size_t);
+        case TL_LOG_ARGUMENT_PTRDIFF: return (u64)va_arg(*arguments, ptrdiff_t);
+        case TL_LOG_ARGUMENT_POINTER:
+        case TL_LOG_ARGUMENT_STRING: return (u64)(uintptr_t)va_arg(*arguments, void*);
+        case TL_LOG_ARGUMENT_DOUBLE: {
+            const f64 value = va_arg(*arguments, double);
+            u64 word;
+            memcpy(&word, &value, sizeof(word));
+            return word;
+        }
+        default: return 0;
+    }
+}
+
+// Replays `format` against the captured words. Strings are read now, so they
+// must still be alive. Running out of words or hitting an unsupported
+// conversion ends the text with "...".
+static void tl_logger_argument_replay(const char* format, const u64* words, const u8 count, char* buffer, const u32 size) {
+    u32 written = 0;
+    u8 argument = 0;
+    const char* c = format;
+
+    while (c != NULL && *c != '\0' && written < size - 1) {
+        if (*c != '%') {
+            buffer[written++] = *c++;
+            continue;
+        }
+
+        TLLogArgument kind;
+        const char* end = tl_logger_argument_parse(c + 1, &kind);
+        if (kind == TL_LOG_ARGUMENT_NONE) {
+            buffer[written++] = '%';
+            c = end;
+            continue;
+        }
+
+        char spec[16];
+        if (kind == TL_LOG_ARGUMENT_UNSUPPORTED || argument >= count || (u64)(end - c) >= sizeof(spec)) {
+            if (size - written > 3) {
+                memcpy(buffer + written, "...", 3);
+                written += 3;
+            }
+            break;
+        }
+        memcpy(spec, c, (u64)(end - c));
+        spec[end - c] = '\0';
+
+        const u64 word = words[argument++];
+        char* out = buffer + written;
+        const u32 left = size - written;
+        i32 length = 0;
+        switch (kind) {
+            case TL_LOG_ARGUMENT_INT: length = snprintf(out, left, spec, (int)word); break;
+            case TL_LOG_ARGUMENT_LONG: length = snprintf(out, left, spec, (long)word); break;
+            case TL_LOG_ARGUMENT_LLONG: length = snprintf(out, left, spec, (long long)word); break;
+            case TL_LOG_ARGUMENT_SIZE: length = snprintf(out, left, spec, (size_t)word); break;
+            case TL_LOG_ARGUMENT_PTRDIFF: length = snprintf(out, left, spec, (ptrdiff_t)word); break;
+            case TL_LOG_ARGUMENT_POINTER: length = snprintf(out, left, spec, (void*)(uintptr_t)word); break;
+            case TL_LOG_ARGUMENT_STRING: length = snprintf(out, left, spec, (const char*)(uintptr_t)word); break;
+            case TL_LOG_ARGUMENT_DOUBLE: {
+                f64 value;
+                memcpy(&value, &word, sizeof(value));
+                length = snprintf(out, left, spec, value);
+            } break;
+            default: break;
+        }
+
+        if (length < 0) break;
+        written += (u32)length < left ? (u32)length : left - 1;
+        c = end;
+    }
+
+    buffer[written] = '\0';
+}
+
+#endif
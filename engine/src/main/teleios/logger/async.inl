@@ -0,0 +1,195 @@
+#ifndef __TELEIOS_LOGGER_ASYNC__
+#define __TELEIOS_LOGGER_ASYNC__
+
+#include "teleios/teleios.h"
+#include <stdatomic.h>
+
+// ---------------------------------
+// Asynchronous mode
+//
+// Producers claim a slot of a bounded MPSC ring with a CAS on `m_enqueued`,
+// copy the formatted line into it and publish it through the slot sequence
+// (Vyukov's bounded queue). The writer thread is the only consumer: it copies
+// ready slots into one batch and hands the batch to a single fwrite. A full
+// ring makes producers wait for the writer, lines are never dropped.
+// ---------------------------------
+#if ! defined(TELEIOS_LOG_RING_SIZE)
+#   define TELEIOS_LOG_RING_SIZE 1024     // Lines, must be a power of two
+#endif
+
+#define TL_LOGGER_BATCH_SIZE (64 * 1024)
+
+typedef struct {
+    _Atomic u64 sequence;                   // Equals the ticket when free, ticket + 1 once written
+    u32 length;
+    char text[TELEIOS_LOG_LENGTH];
+} TLLogSlot;
+
+static TLLogSlot* m_ring = NULL;
+static atomic_bool m_async = false;
+static atomic_bool m_stopping = false;
+static atomic_bool m_writer_idle = false;
+static _Atomic u32 m_producers = 0;         // Threads past the m_async check
+static _Atomic u64 m_enqueued = 0;          // Tickets handed out
+static _Atomic u64 m_written = 0;           // Lines handed to stdout and flushed
+static TLThread* m_writer = NULL;
+static u64 m_writer_id = 0;
+static TLMutex* m_writer_mutex = NULL;
+static TLCondition* m_writer_wakeup = NULL;
+
+static void tl_logger_wake_writer(void) {
+    if (!atomic_load_explicit(&m_writer_idle, memory_order_relaxed)) return;
+
+    tl_mutex_lock(m_writer_mutex);
+    tl_condition_signal(m_writer_wakeup);
+    tl_mutex_unlock(m_writer_mutex);
+}
+
+// Copies a formatted line into the ring, false when it must be written synchronously
+static b8 tl_logger_async_write(const char* line, const u32 length) {
+    // Announced before looking at m_async so tl_logger_async_end can wait for us
+    atomic_fetch_add(&m_producers, 1);
+    if (!atomic_load(&m_async) || tl_thread_current_id() == m_writer_id) {
+        atomic_fetch_sub_explicit(&m_producers, 1, memory_order_release);
+        return false;
+    }
+
+    u64 ticket = atomic_load_explicit(&m_enqueued, memory_order_relaxed);
+    TLLogSlot* slot = NULL;
+    for (;;) {
+        slot = &m_ring[ticket & (TELEIOS_LOG_RING_SIZE - 1)];
+        const u64 sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        const i64 difference = (i64)(sequence - ticket);
+
+        if (difference == 0) {
+            if (atomic_compare_exchange_weak_explicit(&m_enqueued, &ticket, ticket + 1, memory_order_relaxed, memory_order_relaxed)) break;
+        } else if (difference < 0) {
+            // Full, the writer is a whole ring behind
+            tl_logger_wake_writer();
+            tl_thread_sleep(0);
+            ticket = atomic_load_explicit(&m_enqueued, memory_order_relaxed);
+        } else {
+            ticket = atomic_load_explicit(&m_enqueued, memory_order_relaxed);
+        }
+    }
+
+    memcpy(slot->text, line, length);
+    slot->length = length;
+    atomic_store_explicit(&slot->sequence, ticket + 1, memory_order_release);
+
+    tl_logger_wake_writer();
+    atomic_fetch_sub_explicit(&m_producers, 1, memory_order_release);
+    return true;
+}
+
+static void* tl_logger_writer(void* _) {
+    (void)_;
+    char* batch = malloc(TL_LOGGER_BATCH_SIZE);
+    if (batch == NULL) {
+        fprintf(stdout, "Failed to allocate the logger batch\n");
+        exit(99);
+    }
+
+    u64 next = 0;
+    for (;;) {
+        u32 length = 0;
+        for (;;) {
+            TLLogSlot* slot = &m_ring[next & (TELEIOS_LOG_RING_SIZE - 1)];
+            if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != next + 1) break;
+            if (length + slot->length > TL_LOGGER_BATCH_SIZE) break;
+
+            memcpy(batch + length, slot->text, slot->length);
+            length += slot->length;
+            atomic_store_explicit(&slot->sequence, next + TELEIOS_LOG_RING_SIZE, memory_order_release);
+            next++;
+        }
+
+        if (length > 0) {
+            fwrite(batch, 1, length, stdout);
+            fflush(stdout);
+            atomic_store_explicit(&m_written, next, memory_order_release);
+            continue;
+        }
+
+        if (atomic_load_explicit(&m_stopping, memory_order_acquire) && next == atomic_load_explicit(&m_enqueued, memory_order_acquire)) break;
+
+        // The timeout covers a producer that published between the check and the wait
+        tl_mutex_lock(m_writer_mutex);
+        atomic_store_explicit(&m_writer_idle, true, memory_order_relaxed);
+        tl_condition_wait_timeout(m_writer_wakeup, m_writer_mutex, 10);
+        atomic_store_explicit(&m_writer_idle, false, memory_order_relaxed);
+        tl_mutex_unlock(m_writer_mutex);
+    }
+
+    free(batch);
+    return NULL;
+}
+
+b8 tl_logger_async_begin(void) {
+    if (atomic_load_explicit(&m_async, memory_order_acquire)) return false;
+
+    m_ring = malloc(sizeof(TLLogSlot) * TELEIOS_LOG_RING_SIZE);
+    if (m_ring == NULL) {
+        TLERROR("Failed to allocate the logger ring")
+        return false;
+    }
+
+    for (u64 i = 0; i < TELEIOS_LOG_RING_SIZE; ++i) {
+        atomic_init(&m_ring[i].sequence, i);
+    }
+
+    atomic_store_explicit(&m_enqueued, 0, memory_order_relaxed);
+    atomic_store_explicit(&m_written, 0, memory_order_relaxed);
+    atomic_store_explicit(&m_stopping, false, memory_order_relaxed);
+    m_writer_mutex = tl_mutex_create(global->allocator, "logger");
+    m_writer_wakeup = tl_condition_create(global->allocator);
+    m_writer = tl_thread_create(global->allocator, tl_logger_writer, NULL);
+    if (m_writer == NULL) {
+        tl_condition_destroy(m_writer_wakeup);
+        tl_mutex_destroy(m_writer_mutex);
+        free(m_ring);
+        m_ring = NULL;
+        TLERROR("Failed to start the logger writer")
+        return false;
+    }
+
+    m_writer_id = tl_thread_id(m_writer);
+    atomic_store_explicit(&m_async, true, memory_order_release);
+    return true;
+}
+
+static void tl_logger_async_flush(void) {
+    if (!atomic_load_explicit(&m_async, memory_order_acquire) || tl_thread_current_id() == m_writer_id) {
+        fflush(stdout);
+        return;
+    }
+
+    const u64 target = atomic_load_explicit(&m_enqueued, memory_order_acquire);
+    while (atomic_load_explicit(&m_written, memory_order_acquire) < target) {
+        tl_logger_wake_writer();
+        tl_thread_sleep(0);
+    }
+}
+
+void tl_logger_async_end(void) {
+    if (!atomic_load_explicit(&m_async, memory_order_acquire)) return;
+
+    // New lines go straight to stdout, the writer drains what was queued
+    atomic_store(&m_async, false);
+    while (atomic_load_explicit(&m_producers, memory_order_acquire) > 0) tl_thread_sleep(0);
+    atomic_store_explicit(&m_stopping, true, memory_order_release);
+
+    tl_mutex_lock(m_writer_mutex);
+    tl_condition_signal(m_writer_wakeup);
+    tl_mutex_unlock(m_writer_mutex);
+
+    tl_thread_join(m_writer, NULL);
+    m_writer = NULL;
+
+    tl_condition_destroy(m_writer_wakeup);
+    tl_mutex_destroy(m_writer_mutex);
+    free(m_ring);
+    m_ring = NULL;
+}
+
+#endif
@@ -0,0 +1,464 @@
+#ifndef __TELEIOS_LOGGER_BINARY__
+#define __TELEIOS_LOGGER_BINARY__
+
+#include "teleios/teleios.h"
+#include <stdatomic.h>
+
+// ---------------------------------
+// Binary log
+//
+// TLVERBOSE/TLTRACE/TLDEBUG sites are described once per file, then each call
+// only stores the site id, the epoch millis, the thread and the raw argument
+// words; strings are copied. Records go to a per-thread buffer that is written
+// out when full, so the file sees few large writes and the caller never runs
+// vsnprintf. tl_logger_binary_decode() rebuilds the text.
+//
+// File: "TLBL", u32 version, then records of u8 kind, u16 payload size, payload
+// (host byte order).
+//   site:  u32 id, u8 level, u32 lineno, u16 + filename, u16 + format
+//   event: u32 id, u64 millis, u64 thread, u8 argc, argc * (u64 word | u16 + string)
+//
+// Site descriptions are written straight to the file, under the same lock as
+// the buffer writes, before any event that refers to them can be.
+// ---------------------------------
+#define TL_LOGGER_BINARY_MAGIC "TLBL"
+#define TL_LOGGER_BINARY_VERSION 1
+#define TL_LOGGER_BINARY_SITE 'S'
+#define TL_LOGGER_BINARY_EVENT 'E'
+
+#define TL_LOGGER_BINARY_BUFFER (16 * 1024)
+#define TL_LOGGER_BINARY_THREADS 64
+#define TL_LOGGER_BINARY_ARGUMENTS 8
+#define TL_LOGGER_BINARY_STRING 255              // Bytes kept of a %s argument
+#define TL_LOGGER_BINARY_TEXT 4096                // Bytes kept of a site filename or format
+#define TL_LOGGER_BINARY_SITES (1u << 20)         // Highest site id the decoder accepts, far past any call site count
+#define TL_LOGGER_BINARY_RECORD (3 + 4 + 8 + 8 + 1 + TL_LOGGER_BINARY_ARGUMENTS * (2 + TL_LOGGER_BINARY_STRING))
+
+typedef struct {
+    atomic_flag lock;       // Owner thread and flushes, almost never contended
+    u32 used;
+    u8 data[TL_LOGGER_BINARY_BUFFER];
+} TLLogBuffer;
+
+static atomic_flag m_binary_lock = ATOMIC_FLAG_INIT;    // Guards the file and the buffer list
+static FILE* m_binary_file = NULL;
+static atomic_bool m_binary = false;
+static _Atomic u32 m_binary_session = 0;                // Bumped by every tl_logger_binary_begin
+static u32 m_binary_sites = 0;                          // Last site id handed out
+
+// Buffers outlive their thread and the session: they are reused by the next
+// file and released with the process
+static TLLogBuffer* m_binary_buffers[TL_LOGGER_BINARY_THREADS];
+static u32 m_binary_buffer_count = 0;
+static TL_THREADLOCAL TLLogBuffer* m_binary_local = NULL;
+static TL_THREADLOCAL b8 m_binary_unbuffered = false;  // Every buffer taken, write straight to the file
+
+static void tl_logger_binary_lock(void) {
+    while (atomic_flag_test_and_set_explicit(&m_binary_lock, memory_order_acquire)) {
+        // Held across fwrite, let the holder run
+        tl_thread_sleep(0);
+    }
+}
+
+static void tl_logger_binary_unlock(void) {
+    atomic_flag_clear_explicit(&m_binary_lock, memory_order_release);
+}
+
+static void tl_logger_buffer_lock(TLLogBuffer* buffer) {
+    while (atomic_flag_test_and_set_explicit(&buffer->lock, memory_order_acquire)) {
+        // Only a flush from another thread competes with the owner
+    }
+}
+
+static void tl_logger_buffer_unlock(TLLogBuffer* buffer) {
+    atomic_flag_clear_explicit(&buffer->lock, memory_order_release);
+}
+
+// Buffer lock held
+static void tl_logger_buffer_drain(TLLogBuffer* buffer) {
+    if (buffer->used == 0) return;
+
+    tl_logger_binary_lock();
+    if (m_binary_file != NULL) fwrite(buffer->data, 1, buffer->used, m_binary_file);
+    tl_logger_binary_unlock();
+
+    buffer->used = 0;
+}
+
+static u32 tl_logger_binary_buffers(TLLogBuffer** buffers) {
+    tl_logger_binary_lock();
+    const u32 count = m_binary_buffer_count;
+    memcpy(buffers, m_binary_buffers, sizeof(TLLogBuffer*) * count);
+    tl_logger_binary_unlock();
+
+    return count;
+}
+
+static u8* tl_logger_binary_put(u8* at, const void* data, const u32 size) {
+    memcpy(at, data, size);
+    return at + size;
+}
+
+static u8* tl_logger_binary_put_text(u8* at, const char* text, const u16 length) {
+    at = tl_logger_binary_put(at, &length, sizeof(length));
+    return tl_logger_binary_put(at, text, length);
+}
+
+static void tl_logger_binary_describe(TLLogSite* site, const u32 session) {
+    tl_logger_binary_lock();
+
+    // Another thread may have described it while we waited
+    if (atomic_load_explicit(&site->session, memory_order_relaxed) != session) {
+        u32 id = atomic_load_explicit(&site->id, memory_order_relaxed);
+        if (id == 0) {
+            id = ++m_binary_sites;
+            atomic_store_explicit(&site->id, id, memory_order_relaxed);
+        }
+
+        const size_t filename = strlen(site->filename);
+        const size_t format = strlen(site->format);
+        const u16 filename_length = (u16)(filename < TL_LOGGER_BINARY_TEXT ? filename : TL_LOGGER_BINARY_TEXT);
+        const u16 format_length = (u16)(format < TL_LOGGER_BINARY_TEXT ? format : TL_LOGGER_BINARY_TEXT);
+        const u16 size = (u16)(sizeof(id) + 1 + sizeof(site->lineno) + 2 + filename_length + 2 + format_length);
+
+        if (m_binary_file != NULL) {
+            const u8 kind = TL_LOGGER_BINARY_SITE;
+            const u8 level = (u8)site->level;
+            fwrite(&kind, 1, 1, m_binary_file);
+            fwrite(&size, sizeof(size), 1, m_binary_file);
+            fwrite(&id, sizeof(id), 1, m_binary_file);
+            fwrite(&level, 1, 1, m_binary_file);
+            fwrite(&site->lineno, sizeof(site->lineno), 1, m_binary_file);
+            fwrite(&filename_length, sizeof(filename_length), 1, m_binary_file);
+            fwrite(site->filename, 1, filename_length, m_binary_file);
+            fwrite(&format_length, sizeof(format_length), 1, m_binary_file);
+            fwrite(site->format, 1, format_length, m_binary_file);
+        }
+
+        atomic_store_explicit(&site->session, session, memory_order_release);
+    }
+
+    tl_logger_binary_unlock();
+}
+
+static void tl_logger_binary_append(const u8* record, const u32 size) {
+    if (m_binary_local == NULL && !m_binary_unbuffered) {
+        TLLogBuffer* buffer = malloc(sizeof(TLLogBuffer));
+        if (buffer != NULL) {
+            atomic_flag_clear(&buffer->lock);
+            buffer->used = 0;
+        }
+
+        tl_logger_binary_lock();
+        if (buffer != NULL && m_binary_buffer_count < TL_LOGGER_BINARY_THREADS) {
+            m_binary_buffers[m_binary_buffer_count++] = buffer;
+            m_binary_local = buffer;
+        }
+        tl_logger_binary_unlock();
+
+        if (m_binary_local == NULL) {
+            free(buffer);
+            m_binary_unbuffered = true;
+        }
+    }
+
+    TLLogBuffer* buffer = m_binary_local;
+    if (buffer == NULL) {
+        tl_logger_binary_lock();
+        if (m_binary_file != NULL) fwrite(record, 1, size, m_binary_file);
+        tl_logger_binary_unlock();
+        return;
+    }
+
+    tl_logger_buffer_lock(buffer);
+    if (buffer->used + size > TL_LOGGER_BINARY_BUFFER) tl_logger_buffer_drain(buffer);
+    memcpy(buffer->data + buffer->used, record, size);
+    buffer->used += size;
+    tl_logger_buffer_unlock(buffer);
+}
+
+static void tl_logger_binary_write(TLLogSite* site, va_list arguments) {
+    const u32 session = atomic_load_explicit(&m_binary_session, memory_order_acquire);
+    if (atomic_load_explicit(&site->session, memory_order_acquire) != session) {
+        tl_logger_binary_describe(site, session);
+    }
+
+    u8 record[TL_LOGGER_BINARY_RECORD];
+    u8* at = record + 3;
+
+    const u32 id = atomic_load_explicit(&site->id, memory_order_relaxed);
+    const u64 millis = tl_time_epoch_millis();
+    const u64 thread = tl_thread_current_id();
+    at = tl_logger_binary_put(at, &id, sizeof(id));
+    at = tl_logger_binary_put(at, &millis, sizeof(millis));
+    at = tl_logger_binary_put(at, &thread, sizeof(thread));
+
+    u8* argc = at++;
+    *argc = 0;
+
+    va_list copy; va_copy(copy, arguments);
+    for (const char* c = site->format; *c != '\0' && *argc < TL_LOGGER_BINARY_ARGUMENTS; ) {
+        if (*c++ != '%') continue;
+
+        TLLogArgument kind;
+        c = tl_logger_argument_parse(c, &kind);
+        if (kind == TL_LOG_ARGUMENT_NONE) continue;
+        if (kind == TL_LOG_ARGUMENT_UNSUPPORTED) break;
+
+        const u64 word = tl_logger_argument_word(kind, &copy);
+        if (kind == TL_LOG_ARGUMENT_STRING) {
+            // glibc prints "(null)", keep the decoded text identical
+            const char* text = word == 0 ? "(null)" : (const char*)(uintptr_t)word;
+            const char* end = memchr(text, '\0', TL_LOGGER_BINARY_STRING);
+            at = tl_logger_binary_put_text(at, text, (u16)(end != NULL ? end - text : TL_LOGGER_BINARY_STRING));
+        } else {
+            at = tl_logger_binary_put(at, &word, sizeof(word));
+        }
+
+        (*argc)++;
+    }
+    va_end(copy);
+
+    const u8 kind = TL_LOGGER_BINARY_EVENT;
+    const u16 size = (u16)(at - record - 3);
+    record[0] = kind;
+    memcpy(record + 1, &size, sizeof(size));
+
+    tl_logger_binary_append(record, (u32)(at - record));
+}
+
+static void tl_logger_binary_flush(void) {
+    if (!atomic_load_explicit(&m_binary, memory_order_acquire)) return;
+
+    TLLogBuffer* buffers[TL_LOGGER_BINARY_THREADS];
+    const u32 count = tl_logger_binary_buffers(buffers);
+    for (u32 i = 0; i < count; ++i) {
+        tl_logger_buffer_lock(buffers[i]);
+        tl_logger_buffer_drain(buffers[i]);
+        tl_logger_buffer_unlock(buffers[i]);
+    }
+
+    tl_logger_binary_lock();
+    if (m_binary_file != NULL) fflush(m_binary_file);
+    tl_logger_binary_unlock();
+}
+
+b8 tl_logger_binary_begin(const char* path) {
+    tl_logger_binary_lock();
+    if (m_binary_file != NULL) {
+        tl_logger_binary_unlock();
+        return false;
+    }
+
+    m_binary_file = fopen(path, "wb");
+    if (m_binary_file != NULL) {
+        const u32 version = TL_LOGGER_BINARY_VERSION;
+        fwrite(TL_LOGGER_BINARY_MAGIC, 1, 4, m_binary_file);
+        fwrite(&version, sizeof(version), 1, m_binary_file);
+    }
+    const b8 opened = m_binary_file != NULL;
+    tl_logger_binary_unlock();
+
+    if (!opened) {
+        TLERROR("Failed to create the binary log %s", path)
+        return false;
+    }
+
+    // Records that raced the previous tl_logger_binary_end belong to no file
+    TLLogBuffer* buffers[TL_LOGGER_BINARY_THREADS];
+    const u32 count = tl_logger_binary_buffers(buffers);
+    for (u32 i = 0; i < count; ++i) {
+        tl_logger_buffer_lock(buffers[i]);
+        buffers[i]->used = 0;
+        tl_logger_buffer_unlock(buffers[i]);
+    }
+
+    atomic_fetch_add_explicit(&m_binary_session, 1, memory_order_release);
+    atomic_store_explicit(&m_binary, true, memory_order_release);
+    return true;
+}
+
+void tl_logger_binary_end(void) {
+    if (!atomic_load_explicit(&m_binary, memory_order_acquire)) return;
+
+    tl_logger_binary_flush();
+    atomic_store_explicit(&m_binary, false, memory_order_release);
+
+    // Anything logged between the flush and the store above
+    TLLogBuffer* buffers[TL_LOGGER_BINARY_THREADS];
+    const u32 count = tl_logger_binary_buffers(buffers);
+    for (u32 i = 0; i < count; ++i) {
+        tl_logger_buffer_lock(buffers[i]);
+        tl_logger_buffer_drain(buffers[i]);
+        tl_logger_buffer_unlock(buffers[i]);
+    }
+
+    tl_logger_binary_lock();
+    fclose(m_binary_file);
+    m_binary_file = NULL;
+    tl_logger_binary_unlock();
+}
+
+// ---------------------------------
+// Decoder
+// ---------------------------------
+typedef struct {
+    TLLogLevel level;
+    u32 lineno;
+    char* filename;
+    char* format;
+} TLLogDecodedSite;
+
+// Reads `size` bytes from the payload, false when it runs out
+static b8 tl_logger_binary_take(const u8** at, const u8* end, void* data, const u32 size) {
+    if ((u64)(end - *at) < size) return false;
+    memcpy(data, *at, size);
+    *at += size;
+    return true;
+}
+
+static char* tl_logger_binary_take_text(const u8** at, const u8* end) {
+    u16 length;
+    if (!tl_logger_binary_take(at, end, &length, sizeof(length))) return NULL;
+    if ((u64)(end - *at) < length) return NULL;
+
+    char* text = malloc((u64)length + 1);
+    if (text == NULL) return NULL;
+    memcpy(text, *at, length);
+    text[length] = '\0';
+    *at += length;
+    return text;
+}
+
+static u32 tl_logger_format_decoded(char* buffer, const TLLogLevel level, const u64 epoch_millis, const u64 thread, const char* filename, const u32 lineno, const char* message, ...) {
+    va_list arg_ptr; va_start(arg_ptr, message);
+    const u32 length = tl_logger_format(buffer, level, epoch_millis, thread, filename, lineno, message, arg_ptr);
+    va_end(arg_ptr);
+    return length;
+}
+
+static b8 tl_logger_binary_event(const TLLogDecodedSite* site, const u8* at, const u8* end, FILE* output) {
+    u32 id;
+    u64 millis, thread;
+    u8 argc;
+    if (!tl_logger_binary_take(&at, end, &id, sizeof(id))) return false;
+    if (!tl_logger_binary_take(&at, end, &millis, sizeof(millis))) return false;
+    if (!tl_logger_binary_take(&at, end, &thread, sizeof(thread))) return false;
+    if (!tl_logger_binary_take(&at, end, &argc, sizeof(argc))) return false;
+    if (argc > TL_LOGGER_BINARY_ARGUMENTS) return false;
+
+    // The format tells which words are strings, in capture order
+    u64 words[TL_LOGGER_BINARY_ARGUMENTS];
+    char texts[TL_LOGGER_BINARY_ARGUMENTS][TL_LOGGER_BINARY_STRING + 1];
+    u8 count = 0;
+    for (const char* c = site->format; *c != '\0' && count < argc; ) {
+        if (*c++ != '%') continue;
+
+        TLLogArgument kind;
+        c = tl_logger_argument_parse(c, &kind);
+        if (kind == TL_LOG_ARGUMENT_NONE) continue;
+        if (kind == TL_LOG_ARGUMENT_UNSUPPORTED) return false;
+
+        if (kind == TL_LOG_ARGUMENT_STRING) {
+            u16 length;
+            if (!tl_logger_binary_take(&at, end, &length, sizeof(length))) return false;
+            if (length > TL_LOGGER_BINARY_STRING) return false;
+            if (!tl_logger_binary_take(&at, end, texts[count], length)) return false;
+            texts[count][length] = '\0';
+            words[count] = (u64)(uintptr_t)texts[count];
+        } else if (!tl_logger_binary_take(&at, end, &words[count], sizeof(u64))) {
+            return false;
+        }
+
+        count++;
+    }
+    if (count != argc) return false;
+
+    char message[TELEIOS_LOG_LENGTH];
+    tl_logger_argument_replay(site->format, words, count, message, sizeof(message));
+
+    char line[TELEIOS_LOG_LENGTH];
+    const u32 length = tl_logger_format_decoded(line, site->level, millis, thread, site->filename, site->lineno, "%s", message);
+    if (length > 0) fwrite(line, 1, length, output);
+    return true;
+}
+
+b8 tl_logger_binary_decode(FILE* input, FILE* output) {
+    char magic[4];
+    u32 version;
+    if (fread(magic, 1, 4, input) != 4 || memcmp(magic, TL_LOGGER_BINARY_MAGIC, 4) != 0) return false;
+    if (fread(&version, sizeof(version), 1, input) != 1 || version != TL_LOGGER_BINARY_VERSION) return false;
+
+    TLLogDecodedSite* sites = NULL;
+    u32 capacity = 0;
+    u8 payload[U16_MAX];
+    b8 valid = true;
+
+    for (;;) {
+        u8 kind;
+        u16 size;
+        if (fread(&kind, 1, 1, input) != 1) break;
+        if (fread(&size, sizeof(size), 1, input) != 1 || fread(payload, 1, size, input) != size) {
+            valid = false;
+            break;
+        }
+
+        const u8* at = payload;
+        const u8* end = payload + size;
+        if (kind == TL_LOGGER_BINARY_SITE) {
+            u32 id, lineno;
+            u8 level;
+            if (!tl_logger_binary_take(&at, end, &id, sizeof(id))
+             || !tl_logger_binary_take(&at, end, &level, sizeof(level))
+             || !tl_logger_binary_take(&at, end, &lineno, sizeof(lineno))
+             || id == 0 || id > TL_LOGGER_BINARY_SITES || level > TL_LOG_LEVEL_FATAL) {
+                valid = false;
+                break;
+            }
+
+            if (id >= capacity) {
+                // Bounded above, so the doubled capacity cannot wrap
+                const u32 grown = id * 2;
+                TLLogDecodedSite* resized = realloc(sites, sizeof(TLLogDecodedSite) * grown);
+                if (resized == NULL) { valid = false; break; }
+                memset(resized + capacity, 0, sizeof(TLLogDecodedSite) * (grown - capacity));
+                sites = resized;
+                capacity = grown;
+            }
+
+            TLLogDecodedSite* site = &sites[id];
+            free(site->filename);
+            free(site->format);
+            site->level = (TLLogLevel)level;
+            site->lineno = lineno;
+            site->filename = tl_logger_binary_take_text(&at, end);
+            site->format = tl_logger_binary_take_text(&at, end);
+            if (site->filename == NULL || site->format == NULL) { valid = false; break; }
+            continue;
+        }
+
+        if (kind != TL_LOGGER_BINARY_EVENT) {
+            valid = false;
+            break;
+        }
+
+        // Events of a site this file never described raced an earlier session
+        u32 id;
+        if (!tl_logger_binary_take(&at, end, &id, sizeof(id))) { valid = false; break; }
+        if (id >= capacity || sites[id].format == NULL) continue;
+
+        if (!tl_logger_binary_event(&sites[id], payload, end, output)) {
+            valid = false;
+            break;
+        }
+    }
+
+    for (u32 i = 0; i < capacity; ++i) {
+        free(sites[i].filename);
+        free(sites[i].format);
+    }
+    free(sites);
+    return valid;
+}
+
+#endif
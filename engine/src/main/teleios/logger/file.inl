@@ -0,0 +1,139 @@
+#ifndef __TELEIOS_LOGGER_FILE__
+#define __TELEIOS_LOGGER_FILE__
+
+#include "teleios/teleios.h"
+#include <stdatomic.h>
+
+// ---------------------------------
+// File sink
+//
+// Lines are copied, without their ANSI colors, into a preallocated segment
+// mapped by tl_platform_file_map(): a line costs a memcpy, the kernel writes
+// the pages back on its own. When the next line does not fit, the segment is
+// cut to its used size and rotated: path -> path.1 -> ... -> path.<rotations>,
+// the oldest one is deleted and a fresh segment is mapped at path.
+// ---------------------------------
+#if ! defined(TELEIOS_LOG_FILE_MINIMUM)
+#   define TELEIOS_LOG_FILE_MINIMUM (64 * 1024)     // Smallest segment, a few hundred lines
+#endif
+
+#define TL_LOGGER_FILE_PATH 256
+
+static atomic_flag m_file_lock = ATOMIC_FLAG_INIT;
+static char* m_file_base = NULL;
+static u64 m_file_size = 0;
+static u64 m_file_used = 0;
+static void* m_file_handle = NULL;
+static u32 m_file_rotations = 0;
+static char m_file_path[TL_LOGGER_FILE_PATH];
+
+// Set while this thread holds the lock: the platform layer reports map
+// failures with TLERROR, which must not come back into the sink
+static TL_THREADLOCAL b8 m_file_busy = false;
+
+static void tl_logger_file_lock(void) {
+    while (atomic_flag_test_and_set_explicit(&m_file_lock, memory_order_acquire)) {
+        // Rotation holds it across syscalls, let the holder run
+        tl_thread_sleep(0);
+    }
+    m_file_busy = true;
+}
+
+static void tl_logger_file_unlock(void) {
+    m_file_busy = false;
+    atomic_flag_clear_explicit(&m_file_lock, memory_order_release);
+}
+
+// Lock held. Shifts the segments by one and maps a fresh one, the sink stays
+// closed if that fails.
+static void tl_logger_file_rotate(void) {
+    tl_platform_file_unmap(m_file_base, m_file_size, m_file_used, m_file_handle);
+    m_file_base = NULL;
+    m_file_handle = NULL;
+    m_file_used = 0;
+
+    char from[TL_LOGGER_FILE_PATH + 16];
+    char to[TL_LOGGER_FILE_PATH + 16];
+    if (m_file_rotations == 0) {
+        remove(m_file_path);
+    } else {
+        snprintf(to, sizeof(to), "%s.%u", m_file_path, m_file_rotations);
+        remove(to);
+
+        for (u32 i = m_file_rotations; i > 1; --i) {
+            snprintf(from, sizeof(from), "%s.%u", m_file_path, i - 1);
+            snprintf(to, sizeof(to), "%s.%u", m_file_path, i);
+            rename(from, to);
+        }
+
+        snprintf(to, sizeof(to), "%s.1", m_file_path);
+        rename(m_file_path, to);
+    }
+
+    m_file_base = tl_platform_file_map(m_file_path, m_file_size, &m_file_handle);
+}
+
+// Copies `line` into the segment, dropping every "\033[...m" sequence
+static void tl_logger_file_write(const char* line, const u32 length) {
+    if (m_file_busy) return;
+
+    // Colors only ever make lines shorter
+    char plain[TELEIOS_LOG_LENGTH];
+    u32 size = 0;
+    for (u32 i = 0; i < length; ++i) {
+        if (line[i] == '\033' && i + 1 < length && line[i + 1] == '[') {
+            u32 end = i + 2;
+            while (end < length && line[end] != 'm') end++;
+            i = end;
+            continue;
+        }
+        plain[size++] = line[i];
+    }
+
+    tl_logger_file_lock();
+    if (m_file_base != NULL && m_file_used + size > m_file_size) tl_logger_file_rotate();
+    if (m_file_base != NULL) {
+        memcpy(m_file_base + m_file_used, plain, size);
+        m_file_used += size;
+    }
+    tl_logger_file_unlock();
+}
+
+b8 tl_logger_file_begin(const char* path, const u64 segment, const u32 rotations) {
+    if (path == NULL || strlen(path) >= TL_LOGGER_FILE_PATH) {
+        TLERROR("Invalid log file path")
+        return false;
+    }
+
+    tl_logger_file_lock();
+    if (m_file_base != NULL) {
+        tl_logger_file_unlock();
+        return false;
+    }
+
+    snprintf(m_file_path, sizeof(m_file_path), "%s", path);
+    m_file_size = segment < TELEIOS_LOG_FILE_MINIMUM ? TELEIOS_LOG_FILE_MINIMUM : segment;
+    m_file_rotations = rotations;
+    m_file_used = 0;
+    m_file_base = tl_platform_file_map(m_file_path, m_file_size, &m_file_handle);
+    const b8 opened = m_file_base != NULL;
+    tl_logger_file_unlock();
+
+    return opened;
+}
+
+void tl_logger_file_end(void) {
+    // A FATAL raised by the platform while this thread holds the lock
+    if (m_file_busy) return;
+
+    tl_logger_file_lock();
+    if (m_file_base != NULL) {
+        tl_platform_file_unmap(m_file_base, m_file_size, m_file_used, m_file_handle);
+        m_file_base = NULL;
+        m_file_handle = NULL;
+        m_file_used = 0;
+    }
+    tl_logger_file_unlock();
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef __TELEIOS_LOGGER_LIMIT__
+#define __TELEIOS_LOGGER_LIMIT__
+
+#include "teleios/teleios.h"
+#include <stdatomic.h>
+
+// ---------------------------------
+// Rate limited call sites
+//
+// Each TL_LOG_LIMITED site owns a static token bucket. tl_logger_limit_acquire()
+// takes a token inline; only once the bucket is empty does it land here to
+// read the clock and refill by the time elapsed since the last refill. What
+// cannot be refilled is counted as suppressed and reported, from the site,
+// with the next message let through or by tl_logger_limit_flush().
+// ---------------------------------
+
+// Every site that ever refilled, pushed once and never removed: they are statics
+static TLLogLimit* _Atomic m_limits = NULL;
+
+static void tl_logger_limit_report(TLLogLimit* limit) {
+    const u32 suppressed = atomic_exchange_explicit(&limit->suppressed, 0, memory_order_relaxed);
+    if (suppressed == 0) return;
+
+    tl_logger_write(limit->level, limit->filename, limit->lineno, "Suppressed %u similar messages", suppressed);
+}
+
+b8 tl_logger_limit_refill(TLLogLimit* limit) {
+    const u64 now = tl_time_epoch_millis();
+    u64 last = atomic_load_explicit(&limit->refilled, memory_order_relaxed);
+
+    for (;;) {
+        // Another thread may have refilled while this one was getting here
+        i32 tokens = atomic_load_explicit(&limit->tokens, memory_order_relaxed);
+        while (tokens > 0) {
+            if (atomic_compare_exchange_weak_explicit(&limit->tokens, &tokens, tokens - 1, memory_order_relaxed, memory_order_relaxed)) {
+                return true;
+            }
+        }
+
+        u64 gained = limit->burst;
+        u64 refilled = now;
+        if (last != 0) {
+            gained = limit->rate > 0 && now > last ? (now - last) * limit->rate / 1000 : 0;
+
+            // Keep the fraction of a token already earned, unless the bucket overflowed
+            if (gained >= limit->burst) gained = limit->burst;
+            else if (gained > 0) refilled = last + gained * 1000 / limit->rate;
+        }
+
+        if (gained == 0) {
+            atomic_fetch_add_explicit(&limit->suppressed, 1, memory_order_relaxed);
+            return false;
+        }
+
+        // Only the thread moving the timestamp refills, the others retry with its tokens
+        if (atomic_compare_exchange_strong_explicit(&limit->refilled, &last, refilled, memory_order_relaxed, memory_order_relaxed)) {
+            if (last == 0) {
+                limit->next = atomic_load_explicit(&m_limits, memory_order_relaxed);
+                while (!atomic_compare_exchange_weak_explicit(&m_limits, &limit->next, limit, memory_order_release, memory_order_relaxed)) {
+                    // limit->next was reloaded, push again
+                }
+            }
+
+            atomic_store_explicit(&limit->tokens, (i32)gained - 1, memory_order_relaxed);
+            tl_logger_limit_report(limit);
+            return true;
+        }
+    }
+}
+
+void tl_logger_limit_flush(void) {
+    for (TLLogLimit* limit = atomic_load_explicit(&m_limits, memory_order_acquire); limit != NULL; limit = limit->next) {
+        tl_logger_limit_report(limit);
+    }
+}
+
+#endif
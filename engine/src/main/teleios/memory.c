@@ -2,16 +2,37 @@
 #include "teleios/memory/types.inl"
 #include "teleios/memory/linear.inl"
 #include "teleios/memory/dynamic.inl"
+#include "teleios/memory/slab.inl"
+#include "teleios/memory/shared.inl"
+#include "teleios/memory/frame.inl"
+#include "teleios/memory/stack.inl"
+#include "teleios/memory/virtual.inl"
+#include "teleios/memory/stats.inl"
 
 static u16 m_allocators_capacity = 0;
 static u16 m_allocators_count = 0;
 static TLAllocator** m_allocators = NULL;
+static TL_THREADLOCAL TLAllocator* m_scratch = NULL;
+
+// Any thread creates and destroys allocators (its scratch at least) while the
+// main thread walks the registry for telemetry
+static atomic_flag m_allocators_lock = ATOMIC_FLAG_INIT;
+
+static void tl_memory_registry_lock(void) {
+    while (atomic_flag_test_and_set_explicit(&m_allocators_lock, memory_order_acquire)) {
+        // The telemetry dump logs while holding it, let the holder run
+        tl_thread_sleep(0);
+    }
+}
+
+static void tl_memory_registry_unlock(void) {
+    atomic_flag_clear_explicit(&m_allocators_lock, memory_order_release);
+}
 
 void* tl_malloc(const u32 size, const char* error_message) {
     TL_PROFILER_PUSH_WITH("%d, %s", size, error_message)
     void * memory = malloc(size);
     if (memory == NULL) TLFATAL(error_message)
-    memset(memory, 0, size);
     TL_PROFILER_POP_WITH(memory)
 }
 
@@ -22,7 +43,8 @@ b8 tl_memory_initialize(void){
     m_allocators_count = 0;
     m_allocators = tl_malloc(sizeof(TLAllocator*) * m_allocators_capacity, "Failed to allocate TLAllocator* array");
 
-    global->allocator = tl_memory_allocator_create(0, TL_ALLOCATOR_DYNAMIC);
+    // Used by the main and the graphics thread alike
+    global->allocator = tl_memory_allocator_create(0, TL_ALLOCATOR_SHARED);
 
     TL_PROFILER_POP_WITH(true)
 }
@@ -30,24 +52,9 @@ b8 tl_memory_initialize(void){
 TLAllocator* tl_memory_allocator_create(const u32 size, const TLAllocatorType type){
     TL_PROFILER_PUSH_WITH("%u, %s", size, tl_memory_allocator_name(type))
 
-    // Check if we need to grow the allocators array
-    if (m_allocators_count >= m_allocators_capacity) {
-        const u16 new_capacity = m_allocators_capacity * 2;
-        TLAllocator** new_array = tl_malloc(sizeof(TLAllocator*) * new_capacity, "Failed to grow TLAllocator* array");
-
-        // Copy existing allocators to new array
-        if (m_allocators != NULL) {
-            memcpy(new_array, m_allocators, sizeof(TLAllocator*) * m_allocators_count);
-            free(m_allocators);
-        }
-
-        m_allocators = new_array;
-        m_allocators_capacity = new_capacity;
-        TLDEBUG("Allocators array grown to capacity %u", new_capacity);
-    }
-
     // Allocate allocator individually on heap (prevents pointer invalidation)
     TLAllocator* allocator = tl_malloc(sizeof(TLAllocator), "Failed to allocate TLAllocator");
+    memset(allocator, 0, sizeof(TLAllocator));
     allocator->type = type;
 
 #if defined(TELEIOS_BUILD_DEBUG)
@@ -58,19 +65,68 @@ TLAllocator* tl_memory_allocator_create(const u32 size, const TLAllocatorType ty
     if (type == TL_ALLOCATOR_LINEAR) {
         if (size == 0) TLFATAL("LINEAR allocator requires size > 0")
 
-        allocator->linear.page_count = 1;
-        allocator->linear.page = tl_malloc(sizeof(TLMemoryPage), "Failed to allocate TLMemoryPage");
-        allocator->linear.page->size = size;
-        allocator->linear.page->payload = tl_malloc(size, "Failed to allocate TLMemoryPage->payload");
+        allocator->linear.page = tl_memory_linear_page_create(allocator, NULL, size);
+        allocator->linear.current = allocator->linear.page;
+        allocator->linear.page_size = size < TL_MEMORY_LINEAR_PAGE_MAXIMUM ? size * 2 : size;
 
         TLTRACE("LINEAR allocator created:0x%p (page_size=%u)", allocator, size);
+    } else if (type == TL_ALLOCATOR_FRAME) {
+        if (size == 0) TLFATAL("FRAME allocator requires size > 0")
+
+        allocator->frame.size = size;
+        allocator->frame.payload = tl_malloc(size * 2, "Failed to allocate FRAME allocator buffers");
+
+        TLTRACE("FRAME allocator created:0x%p (buffer_size=%u)", allocator, size);
+    } else if (type == TL_ALLOCATOR_STACK) {
+        if (size == 0) TLFATAL("STACK allocator requires size > 0")
+
+        allocator->stack.chunk_size = size;
+        allocator->stack.current = tl_memory_stack_chunk_create(size);
+
+        TLTRACE("STACK allocator created:0x%p (chunk_size=%u)", allocator, size);
+    } else if (type == TL_ALLOCATOR_VIRTUAL) {
+        if (size == 0) TLFATAL("VIRTUAL allocator requires size > 0")
+
+        tl_memory_virtual_create(allocator, size);
+
+        TLTRACE("VIRTUAL allocator created:0x%p (reserved=%llu)", allocator, allocator->vmem.reserved);
+    } else if (type == TL_ALLOCATOR_SLAB) {
+        if (size > 0) TLWARN("SLAB allocator does not requires a size")
+        TLTRACE("SLAB allocator created:0x%p", allocator);
+    } else if (type == TL_ALLOCATOR_SHARED) {
+        if (size > 0) TLWARN("SHARED allocator does not requires a size")
+
+        tl_memory_shared_create(allocator);
+
+        TLTRACE("SHARED allocator created:0x%p", allocator);
     } else {
         if (size > 0) TLWARN("DYNAMIC allocator does not requires a size")
         TLTRACE("DYNAMIC allocator created:0x%p", allocator);
     }
 
     // Add allocator to tracking array
+    u16 grown = 0;
+    tl_memory_registry_lock();
+    if (m_allocators_count >= m_allocators_capacity) {
+        const u16 new_capacity = m_allocators_capacity * 2;
+        TLAllocator** new_array = tl_malloc(sizeof(TLAllocator*) * new_capacity, "Failed to grow TLAllocator* array");
+
+        // Copy existing allocators to new array
+        if (m_allocators != NULL) {
+            memcpy(new_array, m_allocators, sizeof(TLAllocator*) * m_allocators_count);
+            free(m_allocators);
+        }
+
+        m_allocators = new_array;
+        m_allocators_capacity = new_capacity;
+        grown = new_capacity;
+    }
     m_allocators[m_allocators_count++] = allocator;
+    tl_memory_registry_unlock();
+
+    if (grown > 0) {
+        TLDEBUG("Allocators array grown to capacity %u", grown);
+    }
 
     TL_PROFILER_POP_WITH(allocator)
 }
@@ -80,7 +136,10 @@ void tl_memory_allocator_destroy(TLAllocator* allocator){
 
     if (allocator == NULL) TLFATAL("allocator is NULL")
 
+    tl_memory_stats_release(allocator);
+
     // Remove from tracking array
+    tl_memory_registry_lock();
     for (u16 i = 0; i < m_allocators_count; i++) {
         if (m_allocators[i] == allocator) {
             if (i < m_allocators_count - 1) {
@@ -92,6 +151,7 @@ void tl_memory_allocator_destroy(TLAllocator* allocator){
             break;
         }
     }
+    tl_memory_registry_unlock();
 
     switch (allocator->type) {
         case TL_ALLOCATOR_LINEAR:
@@ -100,6 +160,21 @@ void tl_memory_allocator_destroy(TLAllocator* allocator){
         case TL_ALLOCATOR_DYNAMIC:
             tl_memory_dynamic_destroy(allocator);
             break;
+        case TL_ALLOCATOR_SLAB:
+            tl_memory_slab_destroy(allocator);
+            break;
+        case TL_ALLOCATOR_SHARED:
+            tl_memory_shared_destroy(allocator);
+            break;
+        case TL_ALLOCATOR_FRAME:
+            tl_memory_frame_destroy(allocator);
+            break;
+        case TL_ALLOCATOR_STACK:
+            tl_memory_stack_destroy(allocator);
+            break;
+        case TL_ALLOCATOR_VIRTUAL:
+            tl_memory_virtual_destroy(allocator);
+            break;
         default:
             TLFATAL("Unsupported Allocator type %d", allocator->type);
     }
@@ -111,25 +186,162 @@ void tl_memory_allocator_destroy(TLAllocator* allocator){
     TL_PROFILER_POP
 }
 
+// Tag and accounted size of a live block, for allocators that keep them
+static b8 tl_memory_block_info(TLAllocator* allocator, void* pointer, TLMemoryTag* tag, u32* size) {
+    if (allocator->type == TL_ALLOCATOR_DYNAMIC) {
+        TLDynamicBlock* block = tl_memory_dynamic_block(pointer);
+#if TELEIOS_MEMORY_TRACKING
+        if (block->allocator != allocator) return false;
+#endif
+
+        *tag = block->tag;
+        *size = block->size;
+        return true;
+    }
+
+    if (allocator->type == TL_ALLOCATOR_SLAB || allocator->type == TL_ALLOCATOR_SHARED) {
+        TLSlab* slab = tl_memory_slab_header(pointer);
+        if (slab->allocator != allocator) return false;
+
+        *tag = (TLMemoryTag)*tl_memory_slab_tag(slab, pointer);
+        *size = slab->size;
+        return true;
+    }
+
+    return false;
+}
+
+// SLAB and SHARED objects occupy their whole size class, everything else what was asked
+static inline u32 tl_memory_block_footprint(TLAllocator* allocator, void* pointer, const u32 size) {
+    if (allocator->type == TL_ALLOCATOR_SLAB || allocator->type == TL_ALLOCATOR_SHARED) return tl_memory_slab_header(pointer)->size;
+    return size;
+}
+
+static void* tl_memory_allocate(TLAllocator* allocator, const TLMemoryTag tag, const u32 size, const u32 alignment) {
+    TL_PROFILER_PUSH_WITH("0x%p, %d, %u, %u", allocator, tag, size, alignment)
+
+    void* memory = NULL;
+
+    switch (allocator->type) {
+        case TL_ALLOCATOR_LINEAR:
+            memory = tl_memory_linear_alloc(allocator, tag, size, alignment);
+            break;
+        case TL_ALLOCATOR_DYNAMIC:
+            memory = tl_memory_dynamic_alloc(allocator, tag, size, alignment);
+            break;
+        case TL_ALLOCATOR_SLAB:
+            memory = tl_memory_slab_alloc(allocator, tag, size, alignment);
+            break;
+        case TL_ALLOCATOR_SHARED:
+            memory = tl_memory_shared_alloc(allocator, tag, size, alignment);
+            break;
+        case TL_ALLOCATOR_FRAME:
+            memory = tl_memory_frame_alloc(allocator, tag, size, alignment);
+            break;
+        case TL_ALLOCATOR_STACK:
+            memory = tl_memory_stack_alloc(allocator, tag, size, alignment);
+            break;
+        case TL_ALLOCATOR_VIRTUAL:
+            memory = tl_memory_virtual_alloc(allocator, tag, size, alignment);
+            break;
+        default:
+            TLFATAL("Unsupported Allocator type %d", allocator->type);
+    }
+
+    tl_memory_stats_alloc(allocator, tag, tl_memory_block_footprint(allocator, memory, size));
+    TL_PROFILER_POP_WITH(memory)
+}
+
 void* tl_memory_alloc(TLAllocator* allocator, const TLMemoryTag tag, const u32 size){
     TL_PROFILER_PUSH_WITH("0x%p, %d, %u", allocator, tag, size)
 
     if (allocator == NULL) TLFATAL("allocator is NULL")
     if (size == 0) TLFATAL("size is 0")
 
-    void* memory = NULL;
+    void* memory = tl_memory_allocate(allocator, tag, size, TL_MEMORY_DEFAULT_ALIGNMENT);
+    TL_PROFILER_POP_WITH(memory)
+}
 
+void* tl_memory_alloc_zeroed(TLAllocator* allocator, const TLMemoryTag tag, const u32 size){
+    TL_PROFILER_PUSH_WITH("0x%p, %d, %u", allocator, tag, size)
+
+    if (allocator == NULL) TLFATAL("allocator is NULL")
+    if (size == 0) TLFATAL("size is 0")
+
+    void* memory = tl_memory_allocate(allocator, tag, size, TL_MEMORY_DEFAULT_ALIGNMENT);
+    memset(memory, 0, size);
+    TL_PROFILER_POP_WITH(memory)
+}
+
+void* tl_memory_alloc_aligned(TLAllocator* allocator, const TLMemoryTag tag, const u32 size, const u32 alignment){
+    TL_PROFILER_PUSH_WITH("0x%p, %d, %u, %u", allocator, tag, size, alignment)
+
+    if (allocator == NULL) TLFATAL("allocator is NULL")
+    if (size == 0) TLFATAL("size is 0")
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) TLFATAL("alignment %u is not a power of two", alignment)
+
+    // Every allocator already guarantees the default alignment
+    const u32 effective = alignment < TL_MEMORY_DEFAULT_ALIGNMENT ? TL_MEMORY_DEFAULT_ALIGNMENT : alignment;
+    void* memory = tl_memory_allocate(allocator, tag, size, effective);
+    TL_PROFILER_POP_WITH(memory)
+}
+
+void* tl_memory_realloc(TLAllocator* allocator, const TLMemoryTag tag, void* pointer, const u32 old_size, const u32 new_size){
+    TL_PROFILER_PUSH_WITH("0x%p, %d, 0x%p, %u, %u", allocator, tag, pointer, old_size, new_size)
+
+    if (allocator == NULL) TLFATAL("allocator is NULL")
+    if (new_size == 0) TLFATAL("size is 0")
+
+    if (pointer == NULL) {
+        void* memory = tl_memory_allocate(allocator, tag, new_size, TL_MEMORY_DEFAULT_ALIGNMENT);
+        TL_PROFILER_POP_WITH(memory)
+    }
+
+    // Bump allocators only know what the caller tells them
+    TLMemoryTag block_tag = tag;
+    u32 old_bytes = old_size;
+    tl_memory_block_info(allocator, pointer, &block_tag, &old_bytes);
+
+    void* memory = NULL;
     switch (allocator->type) {
         case TL_ALLOCATOR_LINEAR:
-            memory = tl_memory_linear_alloc(allocator, tag, size);
+            memory = tl_memory_linear_resize(allocator, pointer, old_size, new_size);
             break;
         case TL_ALLOCATOR_DYNAMIC:
-            memory = tl_memory_dynamic_alloc(allocator, tag, size);
+            memory = tl_memory_dynamic_resize(allocator, pointer, new_size);
+            break;
+        case TL_ALLOCATOR_SLAB:
+            memory = tl_memory_slab_resize(allocator, pointer, old_size, new_size);
+            break;
+        case TL_ALLOCATOR_SHARED:
+            memory = tl_memory_shared_resize(allocator, pointer, old_size, new_size);
+            break;
+        case TL_ALLOCATOR_FRAME:
+            memory = tl_memory_frame_resize(allocator, pointer, old_size, new_size);
+            break;
+        case TL_ALLOCATOR_STACK:
+            memory = tl_memory_stack_resize(allocator, pointer, old_size, new_size);
+            break;
+        case TL_ALLOCATOR_VIRTUAL:
+            memory = tl_memory_virtual_resize(allocator, pointer, old_size, new_size);
             break;
         default:
             TLFATAL("Unsupported Allocator type %d", allocator->type);
     }
 
+    if (memory != NULL) {
+        tl_memory_stats_resize(allocator, block_tag, old_bytes, tl_memory_block_footprint(allocator, memory, new_size));
+    } else {
+        // Keep whatever alignment the block had, up to a cache line
+        uintptr_t alignment = (uintptr_t)pointer & (~(uintptr_t)pointer + 1);
+        if (alignment > TL_MEMORY_REALLOC_ALIGNMENT_MAXIMUM) alignment = TL_MEMORY_REALLOC_ALIGNMENT_MAXIMUM;
+        if (alignment < TL_MEMORY_DEFAULT_ALIGNMENT) alignment = TL_MEMORY_DEFAULT_ALIGNMENT;
+
+        memory = tl_memory_allocate(allocator, tag, new_size, (u32)alignment);
+        memcpy(memory, pointer, old_size < new_size ? old_size : new_size);
+        tl_memory_free(allocator, pointer);
+    }
+
     TL_PROFILER_POP_WITH(memory)
 }
 
@@ -142,12 +354,28 @@ void tl_memory_free(TLAllocator* allocator, void* pointer){
         TL_PROFILER_POP
     }
 
+    // Read before the block is gone, foreign pointers are reported below
+    TLMemoryTag tag;
+    u32 size;
+    if (tl_memory_block_info(allocator, pointer, &tag, &size)) {
+        tl_memory_stats_free(allocator, tag, size);
+    }
+
     switch (allocator->type) {
         case TL_ALLOCATOR_LINEAR:
+        case TL_ALLOCATOR_FRAME:
+        case TL_ALLOCATOR_STACK:
+        case TL_ALLOCATOR_VIRTUAL:
             break;
         case TL_ALLOCATOR_DYNAMIC:
             tl_memory_dynamic_free(allocator, pointer);
             break;
+        case TL_ALLOCATOR_SLAB:
+            tl_memory_slab_free(allocator, pointer);
+            break;
+        case TL_ALLOCATOR_SHARED:
+            tl_memory_shared_free(allocator, pointer);
+            break;
         default:
             TLFATAL("Unsupported Allocator type %d", allocator->type);
     }
@@ -155,6 +383,229 @@ void tl_memory_free(TLAllocator* allocator, void* pointer){
     TL_PROFILER_POP
 }
 
+void tl_memory_allocator_reset(TLAllocator* allocator) {
+    TL_PROFILER_PUSH_WITH("0x%p", allocator)
+
+    if (allocator == NULL) TLFATAL("allocator is NULL")
+
+    switch (allocator->type) {
+        case TL_ALLOCATOR_LINEAR:
+            tl_memory_linear_reset(allocator);
+            break;
+        case TL_ALLOCATOR_FRAME:
+            tl_memory_frame_reset(allocator);
+            break;
+        case TL_ALLOCATOR_STACK:
+            tl_memory_stack_reset(allocator);
+            break;
+        case TL_ALLOCATOR_VIRTUAL:
+            tl_memory_virtual_reset(allocator);
+            break;
+        default:
+            TLFATAL("%s does not support reset", tl_memory_allocator_name(allocator->type));
+    }
+
+    if (allocator->type == TL_ALLOCATOR_FRAME) {
+        tl_memory_stats_frame_recycle(allocator);
+    } else {
+        tl_memory_stats_release(allocator);
+    }
+
+    TL_PROFILER_POP
+}
+
+TLMemoryMarker tl_memory_stack_push_marker(TLAllocator* allocator) {
+    TL_PROFILER_PUSH_WITH("0x%p", allocator)
+    if (allocator == NULL) TLFATAL("allocator is NULL")
+    if (allocator->type != TL_ALLOCATOR_STACK) TLFATAL("allocator 0x%p is not a STACK allocator", allocator)
+
+    const TLMemoryMarker marker = { allocator->stack.current, allocator->stack.current->offset };
+    TL_PROFILER_POP_WITH(marker)
+}
+
+void tl_memory_stack_pop_to_marker(TLAllocator* allocator, const TLMemoryMarker marker) {
+    TL_PROFILER_PUSH_WITH("0x%p, 0x%p, %u", allocator, marker.chunk, marker.offset)
+    if (allocator == NULL) TLFATAL("allocator is NULL")
+    if (allocator->type != TL_ALLOCATOR_STACK) TLFATAL("allocator 0x%p is not a STACK allocator", allocator)
+    if (marker.chunk == NULL) TLFATAL("marker was not taken from a STACK allocator")
+
+    TLStackChunk* chunk = marker.chunk;
+    chunk->offset = marker.offset;
+    allocator->stack.current = chunk;
+
+    // What is left in use lives in this chunk and the ones below it
+    u64 used = 0;
+    for (TLStackChunk* below = chunk; below != NULL; below = below->prev) used += below->offset;
+    atomic_store_explicit(&allocator->stats.current, used, memory_order_relaxed);
+    tl_memory_budget_lower(&allocator->budget, used);
+
+    TL_PROFILER_POP
+}
+
+TLAllocator* tl_memory_scratch(void) {
+    TL_PROFILER_PUSH
+    if (m_scratch == NULL) {
+        m_scratch = tl_memory_allocator_create(TL_MEMORY_SCRATCH_SIZE, TL_ALLOCATOR_STACK);
+    }
+
+    TL_PROFILER_POP_WITH(m_scratch)
+}
+
+void tl_memory_scratch_release(void) {
+    TL_PROFILER_PUSH
+    if (m_scratch != NULL) {
+        tl_memory_allocator_destroy(m_scratch);
+        m_scratch = NULL;
+    }
+
+    TL_PROFILER_POP
+}
+
+void tl_memory_cache_release(void) {
+    TL_PROFILER_PUSH
+    tl_memory_shared_thread_release();
+    TL_PROFILER_POP
+}
+
+void tl_memory_virtual_set_huge_pages(TLAllocator* allocator, const b8 enabled) {
+    TL_PROFILER_PUSH_WITH("0x%p, %d", allocator, enabled)
+    if (allocator == NULL) TLFATAL("allocator is NULL")
+    if (allocator->type != TL_ALLOCATOR_VIRTUAL) TLFATAL("allocator 0x%p is not a VIRTUAL allocator", allocator)
+
+    allocator->vmem.huge_pages = enabled;
+
+    TL_PROFILER_POP
+}
+
+u32 tl_memory_frame_allocated(const TLAllocator* allocator) {
+    TL_PROFILER_PUSH_WITH("0x%p", allocator)
+    if (allocator == NULL) TLFATAL("allocator is NULL")
+    if (allocator->type != TL_ALLOCATOR_FRAME) TLFATAL("allocator 0x%p is not a FRAME allocator", allocator)
+    TL_PROFILER_POP_WITH(allocator->frame.offset)
+}
+
+u32 tl_memory_frame_peak(const TLAllocator* allocator) {
+    TL_PROFILER_PUSH_WITH("0x%p", allocator)
+    if (allocator == NULL) TLFATAL("allocator is NULL")
+    if (allocator->type != TL_ALLOCATOR_FRAME) TLFATAL("allocator 0x%p is not a FRAME allocator", allocator)
+    TL_PROFILER_POP_WITH(allocator->frame.peak)
+}
+
+TLMemoryStats tl_memory_stats_tag(const TLMemoryTag tag) {
+    TL_PROFILER_PUSH_WITH("%s", tl_memory_type_name(tag))
+    if (tag >= TL_MEMORY_MAXIMUM) TLFATAL("tag %d out of range", tag)
+
+    const TLMemoryStats stats = tl_memory_counter_snapshot(&m_tag_counters[tag]);
+    TL_PROFILER_POP_WITH(stats)
+}
+
+TLMemoryStats tl_memory_stats_allocator(const TLAllocator* allocator) {
+    TL_PROFILER_PUSH_WITH("0x%p", allocator)
+    if (allocator == NULL) TLFATAL("allocator is NULL")
+
+    const TLMemoryStats stats = tl_memory_counter_snapshot(&allocator->stats);
+    TL_PROFILER_POP_WITH(stats)
+}
+
+void tl_memory_stats_frame(void) {
+    TL_PROFILER_PUSH
+
+    for (u32 tag = 0; tag < TL_MEMORY_MAXIMUM; ++tag) {
+        tl_memory_counter_roll(&m_tag_counters[tag]);
+    }
+
+    tl_memory_registry_lock();
+    for (u16 i = 0; i < m_allocators_count; ++i) {
+        tl_memory_counter_roll(&m_allocators[i]->stats);
+    }
+    tl_memory_registry_unlock();
+
+    TL_PROFILER_POP
+}
+
+void tl_memory_stats_dump(void) {
+    TL_PROFILER_PUSH
+
+    tl_memory_registry_lock();
+    TLDEBUG("Memory telemetry: %u allocators", m_allocators_count)
+    for (u32 tag = 0; tag < TL_MEMORY_MAXIMUM; ++tag) {
+        const TLMemoryStats stats = tl_memory_counter_snapshot(&m_tag_counters[tag]);
+        if (stats.allocation_count == 0) continue;
+
+        TLDEBUG("  %-30s %10.1f KiB live %10.1f KiB peak %10llu allocs %6llu/frame",
+            tl_memory_type_name(tag),
+            (f64)stats.current_bytes / 1024.0,
+            (f64)stats.peak_bytes / 1024.0,
+            stats.allocation_count,
+            stats.frame_allocations)
+    }
+
+    for (u16 i = 0; i < m_allocators_count; ++i) {
+        const TLMemoryStats stats = tl_memory_counter_snapshot(&m_allocators[i]->stats);
+        if (stats.allocation_count == 0) continue;
+
+        TLDEBUG("  %-20s 0x%p %10.1f KiB live %10.1f KiB peak %10llu allocs %6llu/frame",
+            tl_memory_allocator_name(m_allocators[i]->type),
+            m_allocators[i],
+            (f64)stats.current_bytes / 1024.0,
+            (f64)stats.peak_bytes / 1024.0,
+            stats.allocation_count,
+            stats.frame_allocations)
+    }
+    tl_memory_registry_unlock();
+
+    TL_PROFILER_POP
+}
+
+void tl_memory_budget_tag(const TLMemoryTag tag, const u64 limit, const u8 soft_percent) {
+    TL_PROFILER_PUSH_WITH("%s, %llu, %u", tl_memory_type_name(tag), limit, soft_percent)
+    if (tag >= TL_MEMORY_MAXIMUM) TLFATAL("tag %d out of range", tag)
+
+    tl_memory_budget_set(&m_tag_budgets[tag], limit, soft_percent);
+    TLDEBUG("Memory budget of %s set to %llu bytes", tl_memory_type_name(tag), limit)
+
+    TL_PROFILER_POP
+}
+
+void tl_memory_budget_allocator(TLAllocator* allocator, const u64 limit, const u8 soft_percent) {
+    TL_PROFILER_PUSH_WITH("0x%p, %llu, %u", allocator, limit, soft_percent)
+    if (allocator == NULL) TLFATAL("allocator is NULL")
+
+    tl_memory_budget_set(&allocator->budget, limit, soft_percent);
+    TLDEBUG("Memory budget of %s 0x%p set to %llu bytes", tl_memory_allocator_name(allocator->type), allocator, limit)
+
+    TL_PROFILER_POP
+}
+
+void tl_memory_budget_configure(void) {
+    TL_PROFILER_PUSH
+
+    char key[96];
+    for (u32 tag = 0; tag < TL_MEMORY_MAXIMUM; ++tag) {
+        // TL_MEMORY_CONTAINER_MAP -> teleios.memory.budget.tag.container_map
+        const char* name = tl_memory_type_name(tag) + sizeof("TL_MEMORY_") - 1;
+        i32 length = snprintf(key, sizeof(key), "teleios.memory.budget.tag.");
+        for (const char* c = name; *c != '\0' && length < (i32)sizeof(key) - 1; ++c) {
+            key[length++] = (char)tolower((unsigned char)*c);
+        }
+        key[length] = '\0';
+
+        snprintf(key + length, sizeof(key) - length, ".mebibytes");
+        const u32 mebibytes = tl_config_get_u32(key);
+        if (mebibytes == 0) continue;
+
+        snprintf(key + length, sizeof(key) - length, ".soft");
+        tl_memory_budget_tag(tag, TL_MEBI_BYTES((u64)mebibytes), tl_config_get_u8(key));
+    }
+
+    const u32 mebibytes = tl_config_get_u32("teleios.memory.budget.allocator.global.mebibytes");
+    if (mebibytes > 0) {
+        tl_memory_budget_allocator(global->allocator, TL_MEBI_BYTES((u64)mebibytes), tl_config_get_u8("teleios.memory.budget.allocator.global.soft"));
+    }
+
+    TL_PROFILER_POP
+}
+
 void tl_memory_set(void *target, const i32 value, const u32 size){
     TL_PROFILER_PUSH_WITH("0x%p, %d, %u", target, value, size)
 
@@ -192,10 +643,15 @@ b8 tl_memory_terminate(void) {
     TL_PROFILER_PUSH
 
     tl_memory_allocator_destroy(global->allocator);
+    tl_memory_scratch_release();
 
     // Release all dangling allocators
-    while (m_allocators_count > 0) {
-        TLAllocator* allocator = m_allocators[m_allocators_count - 1];
+    for (;;) {
+        tl_memory_registry_lock();
+        TLAllocator* allocator = m_allocators_count > 0 ? m_allocators[m_allocators_count - 1] : NULL;
+        tl_memory_registry_unlock();
+        if (allocator == NULL) break;
+
         TLWARN("Releasing dangling allocator 0x%p", allocator)
 #if defined(TELEIOS_BUILD_DEBUG)
         tl_profiler_stacktrace_print(&allocator->stack_trace);
@@ -7,65 +7,136 @@
 // Forward declaration from memory.c
 extern void* tl_malloc(u32 size, const char* error_message);
 
+// ---------------------------------
+// DYNAMIC allocator - header <-> payload conversion
+// ---------------------------------
+static inline void* tl_memory_dynamic_payload(TLDynamicBlock* block) {
+    return (u8*)block + TL_MEMORY_DYNAMIC_HEADER_SIZE;
+}
+
+static inline TLDynamicBlock* tl_memory_dynamic_block(void* pointer) {
+    return (TLDynamicBlock*)((u8*)pointer - TL_MEMORY_DYNAMIC_HEADER_SIZE);
+}
+
 // ---------------------------------
 // DYNAMIC allocator - allocate from heap and track
 // ---------------------------------
-static void* tl_memory_dynamic_alloc(TLAllocator* allocator, const TLMemoryTag tag, const u32 size) {
-    TL_PROFILER_PUSH_WITH("0x%p, %s, %u", allocator, tl_memory_type_name(tag), size)
+static void* tl_memory_dynamic_alloc(TLAllocator* allocator, const TLMemoryTag tag, const u32 size, const u32 alignment) {
+    TL_PROFILER_PUSH_WITH("0x%p, %s, %u, %u", allocator, tl_memory_type_name(tag), size, alignment)
+
+    // Header and payload share a single heap block
+    TLDynamicBlock* block = NULL;
+    if (alignment <= TL_MEMORY_DEFAULT_ALIGNMENT) {
+        block = (TLDynamicBlock*)tl_malloc(TL_MEMORY_DYNAMIC_HEADER_SIZE + size, "Failed to allocate TLDynamicBlock");
+        block->padding = 0;
+    } else {
+        // Over-allocate and slide the header so the payload lands on the boundary. It always
+        // slides, even when the heap block is already aligned, so padding marks the block
+        u8* heap = tl_malloc(TL_MEMORY_DYNAMIC_HEADER_SIZE + size + alignment, "Failed to allocate TLDynamicBlock");
+        const uintptr_t payload = TL_MEMORY_ALIGN_UP((uintptr_t)heap + TL_MEMORY_DYNAMIC_HEADER_SIZE + 1, (uintptr_t)alignment);
+        block = (TLDynamicBlock*)(payload - TL_MEMORY_DYNAMIC_HEADER_SIZE);
+        block->padding = (u32)((u8*)block - heap);
+    }
 
-    TLDynamicBlock* block = (TLDynamicBlock*)tl_malloc(sizeof(TLDynamicBlock), "Failed to allocate TLDynamicBlock");
     block->tag = tag;
     block->size = size;
-    block->next = allocator->dynamic.head;
-    block->pointer = tl_malloc(size, "Failed to allocate");
+#if TELEIOS_MEMORY_TRACKING
+    block->allocator = allocator;
 #ifdef TELEIOS_BUILD_DEBUG
     tl_profiler_stacktrace_snapshot(&block->stack_trace);
 #endif
-    // Insert at head of linked list
+    // Insert at head of the live list
+    block->prev = NULL;
+    block->next = allocator->dynamic.head;
+    if (block->next != NULL) block->next->prev = block;
     allocator->dynamic.head = block;
+#endif
     allocator->dynamic.allocation_count++;
 
+    void* pointer = tl_memory_dynamic_payload(block);
     TLVERBOSE("DYNAMIC alloc: %u bytes (ptr=0x%p, total=%u, tag=%s)",
-        size, block->pointer, allocator->dynamic.allocation_count,
+        size, pointer, allocator->dynamic.allocation_count,
         tl_memory_type_name(tag));
 
-    TL_PROFILER_POP_WITH(block->pointer)
+    TL_PROFILER_POP_WITH(pointer)
 }
 
 // ---------------------------------
-// DYNAMIC allocator - free individual allocation
+// DYNAMIC allocator - resize through realloc, NULL when the block must move
 // ---------------------------------
-static void tl_memory_dynamic_free(TLAllocator* allocator, void* pointer) {
-    TL_PROFILER_PUSH_WITH("0x%p, 0x%p", allocator, pointer)
+static void* tl_memory_dynamic_resize(TLAllocator* allocator, void* pointer, const u32 new_size) {
+    TL_PROFILER_PUSH_WITH("0x%p, 0x%p, %u", allocator, pointer, new_size)
 
-    // Search for block in linked list
-    TLDynamicBlock* prev = NULL;
-    TLDynamicBlock* current = allocator->dynamic.head;
+    TLDynamicBlock* block = tl_memory_dynamic_block(pointer);
+#if TELEIOS_MEMORY_TRACKING
+    if (block->allocator != allocator) {
+        TLFATAL("Pointer 0x%p not found in DYNAMIC allocator 0x%p", pointer, allocator);
+    }
+#endif
 
-    while (current != NULL) {
-        if (current->pointer == pointer) {
-            // Found the block, remove from list
-            if (prev == NULL) {
-                allocator->dynamic.head = current->next;
-            } else {
-                prev->next = current->next;
-            }
+    // Aligned blocks sit at an offset the heap would not preserve
+    if (block->padding != 0) TL_PROFILER_POP_WITH(NULL)
 
-            allocator->dynamic.allocation_count--;
+    // Large blocks are remapped by the heap instead of copied
+    TLDynamicBlock* moved = (TLDynamicBlock*)realloc(block, TL_MEMORY_DYNAMIC_HEADER_SIZE + new_size);
+    if (moved == NULL) TLFATAL("Failed to reallocate TLDynamicBlock to %u bytes", new_size)
 
-            TLVERBOSE("DYNAMIC free: %u bytes (ptr=0x%p, remaining=%u, tag=%s)",
-                current->size, pointer, allocator->dynamic.allocation_count, tl_memory_type_name(current->tag));
+#if TELEIOS_MEMORY_TRACKING
+    if (moved != block) {
+        if (moved->prev == NULL) {
+            allocator->dynamic.head = moved;
+        } else {
+            moved->prev->next = moved;
+        }
 
-            free(current->pointer);
-            free(current);
-            TL_PROFILER_POP
+        if (moved->next != NULL) {
+            moved->next->prev = moved;
         }
+    }
+#else
+    (void)allocator; // Only checked when tracking
+#endif
+
+    void* memory = tl_memory_dynamic_payload(moved);
+    TLVERBOSE("DYNAMIC realloc: %u -> %u bytes (ptr=0x%p -> 0x%p)", moved->size, new_size, pointer, memory);
 
-        prev = current;
-        current = current->next;
+    moved->size = new_size;
+    TL_PROFILER_POP_WITH(memory)
+}
+
+// ---------------------------------
+// DYNAMIC allocator - free individual allocation
+// ---------------------------------
+static void tl_memory_dynamic_free(TLAllocator* allocator, void* pointer) {
+    TL_PROFILER_PUSH_WITH("0x%p, 0x%p", allocator, pointer)
+
+    TLDynamicBlock* block = tl_memory_dynamic_block(pointer);
+#if TELEIOS_MEMORY_TRACKING
+    if (block->allocator != allocator) {
+        TLERROR("Pointer 0x%p not found in DYNAMIC allocator 0x%p", pointer, allocator);
+        TL_PROFILER_POP
+    }
+
+    // Unlink from the live list in O(1)
+    if (block->prev == NULL) {
+        allocator->dynamic.head = block->next;
+    } else {
+        block->prev->next = block->next;
+    }
+
+    if (block->next != NULL) {
+        block->next->prev = block->prev;
     }
 
-    TLERROR("Pointer0x%p not found in DYNAMIC allocator 0x%p", pointer, allocator);
+    // Clear the owner so a stale pointer is rejected instead of corrupting the list
+    block->allocator = NULL;
+#endif
+    allocator->dynamic.allocation_count--;
+
+    TLVERBOSE("DYNAMIC free: %u bytes (ptr=0x%p, remaining=%u, tag=%s)",
+        block->size, pointer, allocator->dynamic.allocation_count, tl_memory_type_name(block->tag));
+
+    free((u8*)block - block->padding);
     TL_PROFILER_POP
 }
 
@@ -76,6 +147,7 @@ static void tl_memory_dynamic_destroy(TLAllocator* allocator) {
     TL_PROFILER_PUSH_WITH("0x%p", allocator)
     if (allocator == NULL) TLFATAL("TLAllocator is NULL")
 
+#if TELEIOS_MEMORY_TRACKING
     // Check for memory leaks in DYNAMIC allocator
     if (allocator->dynamic.head != NULL) {
         u32 leak_count = 0;
@@ -87,22 +159,28 @@ static void tl_memory_dynamic_destroy(TLAllocator* allocator) {
         while (block != NULL) {
             leak_count++;
             leaked_bytes += block->size;
-            TLWARN("  Leak #%u: %u bytes (ptr=0x%p, tag=%s)", leak_count, block->size, block->pointer, tl_memory_type_name(block->tag));
+            TLWARN("  Leak #%u: %u bytes (ptr=0x%p, tag=%s)", leak_count, block->size, tl_memory_dynamic_payload(block), tl_memory_type_name(block->tag));
 #ifdef TELEIOS_BUILD_DEBUG
             tl_profiler_stacktrace_print(&block->stack_trace);
 #endif
             TLDynamicBlock* next = block->next;
-            free(block->pointer);
-            free(block);
+            free((u8*)block - block->padding);
             block = next;
         }
 
         TLERROR("Total memory leaks: %u allocations, %u bytes", leak_count, leaked_bytes);
     }
+#else
+    // Leaked blocks are not reachable without the live list, only their count is known
+    if (allocator->dynamic.allocation_count > 0) {
+        TLERROR("Total memory leaks: %u allocations in allocator 0x%p (build with TELEIOS_MEMORY_TRACKING=1 for details)",
+            allocator->dynamic.allocation_count, allocator);
+    }
+#endif
 
     allocator->dynamic.head = NULL;
     allocator->dynamic.allocation_count = 0;
     TL_PROFILER_POP
 }
 
-#endif
\ No newline at end of file
+#endif
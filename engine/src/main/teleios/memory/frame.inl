@@ -0,0 +1,86 @@
+#ifndef __TELEIOS_MEMORY_FRAME__
+#define __TELEIOS_MEMORY_FRAME__
+
+#include "teleios/teleios.h"
+#include "teleios/memory/types.inl"
+
+// ---------------------------------
+// FRAME allocator - bump inside the current buffer
+// ---------------------------------
+static void* tl_memory_frame_alloc(TLAllocator* allocator, const TLMemoryTag tag, const u32 size, const u32 alignment) {
+    TL_PROFILER_PUSH_WITH("0x%p, %s, %u, %u", allocator, tl_memory_type_name(tag), size, alignment)
+
+    const uintptr_t buffer = (uintptr_t)(allocator->frame.payload + (allocator->frame.current * allocator->frame.size));
+    const u32 offset = (u32)(TL_MEMORY_ALIGN_UP(buffer + allocator->frame.offset, (uintptr_t)alignment) - buffer);
+    if (offset > allocator->frame.size || allocator->frame.size - offset < size) {
+        TLFATAL("FRAME allocator 0x%p exhausted: %u of %u bytes used, %u requested (%s)",
+            allocator, allocator->frame.offset, allocator->frame.size, size, tl_memory_type_name(tag));
+    }
+
+    void* memory = (u8*)buffer + offset;
+    allocator->frame.offset = offset + size;
+    if (allocator->frame.offset > allocator->frame.peak) {
+        allocator->frame.peak = allocator->frame.offset;
+    }
+
+    TLVERBOSE("FRAME alloc:0x%p used %u with %s, available %u", allocator, size, tl_memory_type_name(tag), allocator->frame.size - allocator->frame.offset)
+    TL_PROFILER_POP_WITH(memory)
+}
+
+// ---------------------------------
+// FRAME allocator - grow or shrink the last block in place, NULL when it must move
+// ---------------------------------
+static void* tl_memory_frame_resize(TLAllocator* allocator, void* pointer, const u32 old_size, const u32 new_size) {
+    TL_PROFILER_PUSH_WITH("0x%p, 0x%p, %u, %u", allocator, pointer, old_size, new_size)
+
+    u8* buffer = allocator->frame.payload + (allocator->frame.current * allocator->frame.size);
+
+    // A block of the previous frame moves, its bytes belong to the other buffer
+    if ((u8*)pointer < buffer || (u8*)pointer >= buffer + allocator->frame.size) TL_PROFILER_POP_WITH(NULL)
+
+    if ((u8*)pointer + old_size != buffer + allocator->frame.offset) {
+        // Not the last block, only a shrink can stay where it is
+        TL_PROFILER_POP_WITH(new_size <= old_size ? pointer : NULL)
+    }
+
+    const u32 offset = (u32)((u8*)pointer - buffer);
+    if (allocator->frame.size - offset < new_size) TL_PROFILER_POP_WITH(NULL)
+
+    allocator->frame.offset = offset + new_size;
+    if (allocator->frame.offset > allocator->frame.peak) {
+        allocator->frame.peak = allocator->frame.offset;
+    }
+
+    TL_PROFILER_POP_WITH(pointer)
+}
+
+// ---------------------------------
+// FRAME allocator - flip buffers and rewind in O(1)
+// ---------------------------------
+static void tl_memory_frame_reset(TLAllocator* allocator) {
+    TL_PROFILER_PUSH_WITH("0x%p", allocator)
+
+    allocator->frame.current ^= 1;
+    allocator->frame.offset = 0;
+
+    TL_PROFILER_POP
+}
+
+// ---------------------------------
+// FRAME allocator - destroy both buffers
+// ---------------------------------
+static void tl_memory_frame_destroy(TLAllocator* allocator) {
+    TL_PROFILER_PUSH_WITH("0x%p", allocator)
+    if (allocator == NULL) TLFATAL("TLAllocator is NULL")
+
+    TLDEBUG("FRAME allocator 0x%p peak usage %u of %u bytes", allocator, allocator->frame.peak, allocator->frame.size);
+
+    free(allocator->frame.payload);
+    allocator->frame.payload = NULL;
+    allocator->frame.size = 0;
+    allocator->frame.offset = 0;
+
+    TL_PROFILER_POP
+}
+
+#endif
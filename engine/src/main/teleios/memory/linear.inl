@@ -6,74 +6,138 @@
 // Forward declaration for tl_malloc (defined in memory.c)
 extern void* tl_malloc(u32 size, const char* error_message);
 
+static inline u8* tl_memory_linear_payload(TLMemoryPage* page) {
+    return (u8*)page + TL_MEMORY_LINEAR_HEADER_SIZE;
+}
+
+// Offset of the next free byte honoring `alignment` as an absolute address
+static inline u32 tl_memory_linear_offset(TLMemoryPage* page, const u32 alignment) {
+    const uintptr_t payload = (uintptr_t)tl_memory_linear_payload(page);
+    return (u32)(TL_MEMORY_ALIGN_UP(payload + page->index, (uintptr_t)alignment) - payload);
+}
+
 // ---------------------------------
-// LINEAR allocator - allocate from pages
+// LINEAR allocator - create a page and link it after another one
 // ---------------------------------
-static void* tl_memory_linear_allocate(TLAllocator* allocator, const TLMemoryTag tag, const u32 size) {
-    for (u16 i = 0 ; i < allocator->linear.page_count ; ++i) {
-        TLMemoryPage* page = allocator->linear.page + i;
-        const u32 available = page->size - page->index;
-        if (available < size + sizeof(TLMemoryTag)) continue;
-
-        TLMemory* block = (TLMemory*) (page->payload + page->index);
-        block->tag = tag;
+static TLMemoryPage* tl_memory_linear_page_create(TLAllocator* allocator, TLMemoryPage* previous, const u32 size) {
+    TL_PROFILER_PUSH_WITH("0x%p, 0x%p, %u", allocator, previous, size)
 
-        page->index += sizeof(TLMemoryTag);
-        void* result = page->payload + page->index;
-        page->index += size;
+    TLMemoryPage* page = tl_malloc(TL_MEMORY_LINEAR_HEADER_SIZE + size, "Failed to allocate TLMemoryPage");
+    page->next = NULL;
+    page->size = size;
+    page->index = 0;
 
-        TLVERBOSE("LINEAR alloc:0x%p used %d with %s, available %d", allocator, size, tl_memory_type_name(tag), page->size - page->index)
-        return result;
+    if (previous != NULL) {
+        page->next = previous->next;
+        previous->next = page;
     }
 
-    return NULL;
+    allocator->linear.page_count++;
+    TLVERBOSE("LINEAR page:0x%p (pages=%u, size=%u bytes)", allocator, allocator->linear.page_count, size);
+
+    TL_PROFILER_POP_WITH(page)
 }
 
 // ---------------------------------
-// LINEAR allocator - resize page array
+// LINEAR allocator - move to a page able to hold `size` bytes
 // ---------------------------------
-static void tl_memory_linear_resize(TLAllocator* allocator) {
-    TL_PROFILER_PUSH_WITH("0x%p", allocator)
-
-    const u16 new_page_count = (u16)(allocator->linear.page_count * 1.75f) + 1;
-    TLMemoryPage* new_pages = tl_malloc(sizeof(TLMemoryPage) * new_page_count, "Failed to resize LINEAR allocator");
-    memcpy(new_pages, allocator->linear.page, sizeof(TLMemoryPage) * allocator->linear.page_count);
+static TLMemoryPage* tl_memory_linear_advance(TLAllocator* allocator, const u32 size, const u32 alignment) {
+    TL_PROFILER_PUSH_WITH("0x%p, %u, %u", allocator, size, alignment)
+
+    // Pages kept from before a reset come first
+    TLMemoryPage* page = allocator->linear.current->next;
+    while (page != NULL) {
+        const u32 offset = tl_memory_linear_offset(page, alignment);
+        if (offset <= page->size && page->size - offset >= size) {
+            allocator->linear.current = page;
+            TL_PROFILER_POP_WITH(page)
+        }
 
-    // Initialize the new page with the same size as the first page
-    TLMemoryPage* new_page = new_pages + allocator->linear.page_count;
-    new_page->size = allocator->linear.page->size;
-    new_page->index = 0;
-    new_page->payload = tl_malloc(new_page->size, "Failed to allocate new page payload");
+        page = page->next;
+    }
 
-    free(allocator->linear.page);
-    allocator->linear.page = new_pages;
-    allocator->linear.page_count = new_page_count;
+    page = tl_memory_linear_page_create(allocator, allocator->linear.current, allocator->linear.page_size);
+    allocator->linear.current = page;
 
-    TLVERBOSE("LINEAR allocator resized:0x%p (pages=%u of %llu bytes)", allocator, new_page_count, new_page->size);
+    // Geometric growth keeps the page count logarithmic
+    if (allocator->linear.page_size < TL_MEMORY_LINEAR_PAGE_MAXIMUM) {
+        allocator->linear.page_size *= 2;
+    }
 
-    TL_PROFILER_POP
+    TL_PROFILER_POP_WITH(page)
 }
 
 // ---------------------------------
 // LINEAR allocator - main allocation function
 // ---------------------------------
-static void* tl_memory_linear_alloc(TLAllocator* allocator, const TLMemoryTag tag, const u32 size) {
-    TL_PROFILER_PUSH_WITH("0x%p, %s, %u", allocator, tl_memory_type_name(tag), size)
+static void* tl_memory_linear_alloc(TLAllocator* allocator, const TLMemoryTag tag, const u32 size, const u32 alignment) {
+    TL_PROFILER_PUSH_WITH("0x%p, %s, %u, %u", allocator, tl_memory_type_name(tag), size, alignment)
+    (void)tag; // Only traced
+
+    TLMemoryPage* page = allocator->linear.current;
+    u32 offset = tl_memory_linear_offset(page, alignment);
+
+    if (offset > page->size || page->size - offset < size) {
+        // Payloads start at the default alignment, anything stricter may need padding
+        const u32 worst_case = size + (alignment - TL_MEMORY_DEFAULT_ALIGNMENT);
+        if (worst_case > allocator->linear.page_size) {
+            // Dedicated page behind the current one, which keeps serving small requests
+            page = tl_memory_linear_page_create(allocator, allocator->linear.current, worst_case);
+            offset = tl_memory_linear_offset(page, alignment);
+            page->index = page->size;
+
+            void* memory = tl_memory_linear_payload(page) + offset;
+            TLVERBOSE("LINEAR alloc:0x%p used %u with %s on a dedicated page", allocator, size, tl_memory_type_name(tag))
+            TL_PROFILER_POP_WITH(memory)
+        }
 
-    if (allocator->linear.page->size < size) {
-        TLFATAL("LINEAR allocator page size (%u) is smaller than requested size (%u)",
-            allocator->linear.page->size, size);
+        page = tl_memory_linear_advance(allocator, size, alignment);
+        offset = tl_memory_linear_offset(page, alignment);
     }
 
-    void* memory = tl_memory_linear_allocate(allocator, tag, size);
-    if (memory == NULL) {
-        tl_memory_linear_resize(allocator);
-        memory = tl_memory_linear_allocate(allocator, tag, size);
-    }
+    void* memory = tl_memory_linear_payload(page) + offset;
+    page->index = offset + size;
 
+    TLVERBOSE("LINEAR alloc:0x%p used %u with %s, available %u", allocator, size, tl_memory_type_name(tag), page->size - page->index)
     TL_PROFILER_POP_WITH(memory)
 }
 
+// ---------------------------------
+// LINEAR allocator - grow or shrink the last block in place, NULL when it must move
+// ---------------------------------
+static void* tl_memory_linear_resize(TLAllocator* allocator, void* pointer, const u32 old_size, const u32 new_size) {
+    TL_PROFILER_PUSH_WITH("0x%p, 0x%p, %u, %u", allocator, pointer, old_size, new_size)
+
+    TLMemoryPage* page = allocator->linear.current;
+    u8* payload = tl_memory_linear_payload(page);
+    if ((u8*)pointer + old_size != payload + page->index) {
+        // Not the last block, only a shrink can stay where it is
+        TL_PROFILER_POP_WITH(new_size <= old_size ? pointer : NULL)
+    }
+
+    const u32 offset = (u32)((u8*)pointer - payload);
+    if (page->size - offset < new_size) TL_PROFILER_POP_WITH(NULL)
+
+    page->index = offset + new_size;
+
+    TL_PROFILER_POP_WITH(pointer)
+}
+
+// ---------------------------------
+// LINEAR allocator - rewind every page, keeping them for reuse
+// ---------------------------------
+static void tl_memory_linear_reset(TLAllocator* allocator) {
+    TL_PROFILER_PUSH_WITH("0x%p", allocator)
+
+    for (TLMemoryPage* page = allocator->linear.page; page != NULL; page = page->next) {
+        page->index = 0;
+    }
+
+    allocator->linear.current = allocator->linear.page;
+
+    TL_PROFILER_POP
+}
+
 // ---------------------------------
 // LINEAR allocator - destroy (no individual free support)
 // ---------------------------------
@@ -81,19 +145,18 @@ static void tl_memory_linear_destroy(TLAllocator* allocator) {
     TL_PROFILER_PUSH
     if (allocator == NULL) TLFATAL("TLAllocator is NULL")
 
-    for (u16 i = 0 ; i < allocator->linear.page_count ; ++i) {
-        TLMemoryPage* page = allocator->linear.page + i;
-        if (page->payload != NULL) {
-            free(page->payload);
-            page->payload = NULL;
-        }
+    TLMemoryPage* page = allocator->linear.page;
+    while (page != NULL) {
+        TLMemoryPage* next = page->next;
+        free(page);
+        page = next;
     }
 
-    free(allocator->linear.page);
     allocator->linear.page = NULL;
+    allocator->linear.current = NULL;
     allocator->linear.page_count = 0;
 
     TL_PROFILER_POP
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,381 @@
+#ifndef __TELEIOS_MEMORY_SHARED__
+#define __TELEIOS_MEMORY_SHARED__
+
+#include "teleios/teleios.h"
+#include "teleios/memory/types.inl"
+#include "teleios/memory/slab.inl"
+#if defined(TL_PLATFORM_WINDOWS)
+#   include <windows.h>
+#else
+#   include <sched.h>
+#endif
+
+// Forward declaration from memory.c
+extern void* tl_malloc(u32 size, const char* error_message);
+
+// Thread cache of every live shared allocator, valid while the generations match
+typedef struct {
+    u32 generation;
+    TLMemoryCache* cache;
+} TLMemoryCacheSlot;
+
+static TL_THREADLOCAL TLMemoryCacheSlot m_cache_slots[TL_MEMORY_SHARED_MAXIMUM];
+static TLAllocator* m_shared[TL_MEMORY_SHARED_MAXIMUM];
+static u32 m_shared_generation = 0;
+
+// ---------------------------------
+// SHARED allocator - depot lock and lock-free magazine stacks
+// ---------------------------------
+static inline void tl_memory_depot_lock(TLMemoryDepot* depot) {
+    while (atomic_flag_test_and_set_explicit(&depot->lock, memory_order_acquire)) {
+        // Held only to move magazines or pop free objects, let the holder run.
+        // Not tl_thread_sleep(0): it traces every attempt in debug builds.
+#if defined(TL_PLATFORM_WINDOWS)
+        SwitchToThread();
+#else
+        sched_yield();
+#endif
+    }
+}
+
+static inline void tl_memory_depot_unlock(TLMemoryDepot* depot) {
+    atomic_flag_clear_explicit(&depot->lock, memory_order_release);
+}
+
+static inline void tl_memory_magazine_push(_Atomic(TLMemoryMagazine*)* stack, TLMemoryMagazine* magazine) {
+    TLMemoryMagazine* head = atomic_load_explicit(stack, memory_order_relaxed);
+    do {
+        magazine->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(stack, &head, magazine, memory_order_release, memory_order_relaxed));
+}
+
+// Taking the whole stack at once is what keeps these lists free of ABA
+static inline TLMemoryMagazine* tl_memory_magazine_drain(_Atomic(TLMemoryMagazine*)* stack) {
+    if (atomic_load_explicit(stack, memory_order_relaxed) == NULL) return NULL;
+    return atomic_exchange_explicit(stack, NULL, memory_order_acquire);
+}
+
+static TLMemoryMagazine* tl_memory_magazine_create(void) {
+    TLMemoryMagazine* magazine = tl_malloc(sizeof(TLMemoryMagazine), "Failed to allocate TLMemoryMagazine");
+    magazine->next = NULL;
+    magazine->count = 0;
+    return magazine;
+}
+
+static void tl_memory_magazine_release(TLMemoryMagazine* magazine) {
+    while (magazine != NULL) {
+        TLMemoryMagazine* next = magazine->next;
+        free(magazine);
+        magazine = next;
+    }
+}
+
+// ---------------------------------
+// SHARED allocator - create the depot
+// ---------------------------------
+static void tl_memory_shared_create(TLAllocator* allocator) {
+    TL_PROFILER_PUSH_WITH("0x%p", allocator)
+
+    u8 slot = 0;
+    while (slot < TL_MEMORY_SHARED_MAXIMUM && m_shared[slot] != NULL) slot++;
+    if (slot == TL_MEMORY_SHARED_MAXIMUM) TLFATAL("At most %u SHARED allocators can be alive at once", TL_MEMORY_SHARED_MAXIMUM)
+
+    TLMemoryDepot* depot = tl_malloc(sizeof(TLMemoryDepot), "Failed to allocate TLMemoryDepot");
+    memset(depot, 0, sizeof(TLMemoryDepot));
+    atomic_flag_clear(&depot->lock);
+    for (u32 i = 0; i < TL_MEMORY_SLAB_CLASS_COUNT; ++i) {
+        atomic_init(&depot->returned[i], NULL);
+    }
+    atomic_init(&depot->empty, NULL);
+
+    // Zero is what a thread's slots start with, never hand it out
+    depot->generation = ++m_shared_generation;
+    depot->slot = slot;
+
+    allocator->depot = depot;
+    m_shared[slot] = allocator;
+    TL_PROFILER_POP
+}
+
+// ---------------------------------
+// SHARED allocator - calling thread's cache, created on first use
+// ---------------------------------
+static TLMemoryCache* tl_memory_shared_cache(TLAllocator* allocator) {
+    TLMemoryDepot* depot = allocator->depot;
+    TLMemoryCacheSlot* slot = &m_cache_slots[depot->slot];
+    if (TL_LIKELY(slot->generation == depot->generation)) return slot->cache;
+
+    TLMemoryCache* cache = tl_malloc(sizeof(TLMemoryCache), "Failed to allocate TLMemoryCache");
+    for (u32 i = 0; i < TL_MEMORY_SLAB_CLASS_COUNT; ++i) {
+        cache->loaded[i] = tl_memory_magazine_create();
+        cache->previous[i] = tl_memory_magazine_create();
+    }
+    cache->spare = NULL;
+
+    // The depot releases the caches, threads may be gone by then
+    tl_memory_depot_lock(depot);
+    cache->next = depot->caches;
+    depot->caches = cache;
+    tl_memory_depot_unlock(depot);
+
+    slot->generation = depot->generation;
+    slot->cache = cache;
+    TLVERBOSE("SHARED cache:0x%p created for thread %llu", allocator, tl_thread_current_id())
+    return cache;
+}
+
+// ---------------------------------
+// SHARED allocator - refill the loaded magazine from the depot
+// ---------------------------------
+static void tl_memory_shared_refill(TLAllocator* allocator, TLMemoryCache* cache, const u8 size_class) {
+    TL_PROFILER_PUSH_WITH("0x%p, 0x%p, %u", allocator, cache, size_class)
+    TLMemoryDepot* depot = allocator->depot;
+
+    tl_memory_depot_lock(depot);
+
+    // Magazines freed by other threads join the locked list first
+    TLMemoryMagazine* returned = tl_memory_magazine_drain(&depot->returned[size_class]);
+    while (returned != NULL) {
+        TLMemoryMagazine* next = returned->next;
+        returned->next = depot->full[size_class];
+        depot->full[size_class] = returned;
+        returned = next;
+    }
+
+    TLMemoryMagazine* full = depot->full[size_class];
+    if (full != NULL) {
+        depot->full[size_class] = full->next;
+        tl_memory_depot_unlock(depot);
+        full->next = NULL;
+
+        // Both magazines are empty, keep one and hand the other back
+        tl_memory_magazine_push(&depot->empty, cache->previous[size_class]);
+        cache->previous[size_class] = cache->loaded[size_class];
+        cache->loaded[size_class] = full;
+        TL_PROFILER_POP
+    }
+
+    // Nothing cached anywhere, pop a whole magazine from the slabs at once
+    TLMemoryMagazine* magazine = cache->loaded[size_class];
+    magazine->count = tl_memory_slab_carve(allocator, size_class, magazine->objects, TL_MEMORY_MAGAZINE_SIZE);
+
+    u32 pages = 0;
+    while (magazine->count < TL_MEMORY_MAGAZINE_SIZE) {
+        // The page comes from the heap without holding up the other threads
+        tl_memory_depot_unlock(depot);
+        TLSlab* page = tl_memory_slab_page_alloc(TL_MEMORY_SLAB_PAGE_SIZE);
+        tl_memory_depot_lock(depot);
+
+        tl_memory_slab_format(allocator, page, size_class);
+        magazine->count += tl_memory_slab_carve(allocator, size_class, magazine->objects + magazine->count, TL_MEMORY_MAGAZINE_SIZE - magazine->count);
+        pages++;
+    }
+
+    tl_memory_depot_unlock(depot);
+    TLVERBOSE("SHARED refill:0x%p class %u bytes from the slabs, %u new pages", allocator, TL_MEMORY_SLAB_CLASS_MINIMUM << size_class, pages)
+    TL_PROFILER_POP
+}
+
+// ---------------------------------
+// SHARED allocator - pop from the calling thread's magazine
+// ---------------------------------
+static void* tl_memory_shared_alloc(TLAllocator* allocator, const TLMemoryTag tag, const u32 size, const u32 alignment) {
+    TL_PROFILER_PUSH_WITH("0x%p, %s, %u, %u", allocator, tl_memory_type_name(tag), size, alignment)
+
+    if (size > TL_MEMORY_SLAB_CLASS_MAXIMUM || alignment > TL_MEMORY_SLAB_CLASS_MAXIMUM) {
+        // Large blocks are rare enough to go straight to the slabs
+        tl_memory_depot_lock(allocator->depot);
+        void* memory = tl_memory_slab_alloc(allocator, tag, size, alignment);
+        tl_memory_depot_unlock(allocator->depot);
+        TL_PROFILER_POP_WITH(memory)
+    }
+
+    const u8 size_class = tl_memory_slab_class(size > alignment ? size : alignment);
+    TLMemoryCache* cache = tl_memory_shared_cache(allocator);
+
+    if (cache->loaded[size_class]->count == 0) {
+        if (cache->previous[size_class]->count > 0) {
+            TLMemoryMagazine* swap = cache->loaded[size_class];
+            cache->loaded[size_class] = cache->previous[size_class];
+            cache->previous[size_class] = swap;
+        } else {
+            tl_memory_shared_refill(allocator, cache, size_class);
+        }
+    }
+
+    TLMemoryMagazine* magazine = cache->loaded[size_class];
+    void* memory = magazine->objects[--magazine->count];
+
+    // One byte per object, no other thread writes it while the object is live
+    *tl_memory_slab_tag(tl_memory_slab_header(memory), memory) = (u8)tag;
+
+    TLVERBOSE("SHARED alloc: %u bytes (ptr=0x%p, tag=%s)", size, memory, tl_memory_type_name(tag));
+    TL_PROFILER_POP_WITH(memory)
+}
+
+// ---------------------------------
+// SHARED allocator - keep the object while it fits, NULL when it must move
+// ---------------------------------
+static void* tl_memory_shared_resize(TLAllocator* allocator, void* pointer, const u32 old_size, const u32 new_size) {
+    TL_PROFILER_PUSH_WITH("0x%p, 0x%p, %u, %u", allocator, pointer, old_size, new_size)
+
+    TLSlab* slab = tl_memory_slab_header(pointer);
+    if (slab->size_class != TL_MEMORY_SLAB_CLASS_LARGE) {
+        if (slab->allocator != allocator) TLFATAL("Pointer 0x%p not found in SHARED allocator 0x%p", pointer, allocator)
+        TL_PROFILER_POP_WITH(new_size <= slab->size ? pointer : NULL)
+    }
+
+    tl_memory_depot_lock(allocator->depot);
+    void* memory = tl_memory_slab_resize(allocator, pointer, old_size, new_size);
+    tl_memory_depot_unlock(allocator->depot);
+    TL_PROFILER_POP_WITH(memory)
+}
+
+// ---------------------------------
+// SHARED allocator - push onto the calling thread's magazine
+// ---------------------------------
+static void tl_memory_shared_free(TLAllocator* allocator, void* pointer) {
+    TL_PROFILER_PUSH_WITH("0x%p, 0x%p", allocator, pointer)
+
+    TLSlab* slab = tl_memory_slab_header(pointer);
+    if (slab->allocator != allocator) {
+        TLERROR("Pointer 0x%p not found in SHARED allocator 0x%p", pointer, allocator);
+        TL_PROFILER_POP
+    }
+
+    if (slab->size_class == TL_MEMORY_SLAB_CLASS_LARGE) {
+        tl_memory_depot_lock(allocator->depot);
+        tl_memory_slab_free(allocator, pointer);
+        tl_memory_depot_unlock(allocator->depot);
+        TL_PROFILER_POP
+    }
+
+    const u8 size_class = slab->size_class;
+    TLMemoryCache* cache = tl_memory_shared_cache(allocator);
+
+    if (cache->loaded[size_class]->count == TL_MEMORY_MAGAZINE_SIZE) {
+        if (cache->previous[size_class]->count < TL_MEMORY_MAGAZINE_SIZE) {
+            TLMemoryMagazine* swap = cache->loaded[size_class];
+            cache->loaded[size_class] = cache->previous[size_class];
+            cache->previous[size_class] = swap;
+        } else {
+            // This thread frees more than it allocates, hand a full magazine
+            // to whichever thread refills next without taking the lock
+            TLMemoryDepot* depot = allocator->depot;
+            tl_memory_magazine_push(&depot->returned[size_class], cache->previous[size_class]);
+            cache->previous[size_class] = cache->loaded[size_class];
+
+            if (cache->spare == NULL) cache->spare = tl_memory_magazine_drain(&depot->empty);
+            if (cache->spare == NULL) cache->spare = tl_memory_magazine_create();
+
+            cache->loaded[size_class] = cache->spare;
+            cache->spare = cache->spare->next;
+            cache->loaded[size_class]->next = NULL;
+        }
+    }
+
+    TLMemoryMagazine* magazine = cache->loaded[size_class];
+    magazine->objects[magazine->count++] = pointer;
+
+    TLVERBOSE("SHARED free: %u bytes (ptr=0x%p)", slab->size, pointer);
+    TL_PROFILER_POP
+}
+
+// ---------------------------------
+// SHARED allocator - hand the calling thread's magazines back to every depot
+//
+// Objects stay in their magazines: the non-empty ones become refills for the
+// other threads, the empty ones spares. Without this the cache of a thread
+// that ended would hold its objects until the allocator is destroyed.
+// ---------------------------------
+static void tl_memory_shared_thread_release(void) {
+    for (u32 index = 0; index < TL_MEMORY_SHARED_MAXIMUM; ++index) {
+        TLMemoryCacheSlot* slot = &m_cache_slots[index];
+        TLAllocator* allocator = m_shared[index];
+        if (slot->generation == 0 || allocator == NULL || allocator->depot->generation != slot->generation) continue;
+
+        TLMemoryDepot* depot = allocator->depot;
+        TLMemoryCache* cache = slot->cache;
+        for (u32 size_class = 0; size_class < TL_MEMORY_SLAB_CLASS_COUNT; ++size_class) {
+            TLMemoryMagazine* magazines[2] = { cache->loaded[size_class], cache->previous[size_class] };
+            for (u32 i = 0; i < 2; ++i) {
+                if (magazines[i]->count > 0) {
+                    tl_memory_magazine_push(&depot->returned[size_class], magazines[i]);
+                } else {
+                    tl_memory_magazine_push(&depot->empty, magazines[i]);
+                }
+            }
+        }
+
+        while (cache->spare != NULL) {
+            TLMemoryMagazine* next = cache->spare->next;
+            tl_memory_magazine_push(&depot->empty, cache->spare);
+            cache->spare = next;
+        }
+
+        tl_memory_depot_lock(depot);
+        TLMemoryCache** link = &depot->caches;
+        while (*link != cache) link = &(*link)->next;
+        *link = cache->next;
+        tl_memory_depot_unlock(depot);
+
+        free(cache);
+        slot->generation = 0;
+        slot->cache = NULL;
+    }
+}
+
+// ---------------------------------
+// SHARED allocator - give every cached object back to the slabs, then destroy
+// ---------------------------------
+static void tl_memory_shared_flush(TLAllocator* allocator, TLMemoryMagazine* magazine) {
+    for (; magazine != NULL; magazine = magazine->next) {
+        for (u32 i = 0; i < magazine->count; ++i) {
+            tl_memory_slab_free(allocator, magazine->objects[i]);
+        }
+        magazine->count = 0;
+    }
+}
+
+static void tl_memory_shared_destroy(TLAllocator* allocator) {
+    TL_PROFILER_PUSH_WITH("0x%p", allocator)
+    if (allocator == NULL) TLFATAL("TLAllocator is NULL")
+
+    // Every thread using the allocator must be done with it by now
+    TLMemoryDepot* depot = allocator->depot;
+    for (u32 size_class = 0; size_class < TL_MEMORY_SLAB_CLASS_COUNT; ++size_class) {
+        TLMemoryMagazine* returned = tl_memory_magazine_drain(&depot->returned[size_class]);
+        tl_memory_shared_flush(allocator, returned);
+        tl_memory_magazine_release(returned);
+
+        tl_memory_shared_flush(allocator, depot->full[size_class]);
+        tl_memory_magazine_release(depot->full[size_class]);
+    }
+
+    TLMemoryCache* cache = depot->caches;
+    while (cache != NULL) {
+        for (u32 size_class = 0; size_class < TL_MEMORY_SLAB_CLASS_COUNT; ++size_class) {
+            tl_memory_shared_flush(allocator, cache->loaded[size_class]);
+            tl_memory_shared_flush(allocator, cache->previous[size_class]);
+            tl_memory_magazine_release(cache->loaded[size_class]);
+            tl_memory_magazine_release(cache->previous[size_class]);
+        }
+        tl_memory_magazine_release(cache->spare);
+
+        TLMemoryCache* next = cache->next;
+        free(cache);
+        cache = next;
+    }
+
+    tl_memory_magazine_release(tl_memory_magazine_drain(&depot->empty));
+
+    // Whatever the slabs still count as used was never freed
+    tl_memory_slab_destroy(allocator);
+
+    m_shared[depot->slot] = NULL;
+    free(depot);
+    allocator->depot = NULL;
+    TL_PROFILER_POP
+}
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef __TELEIOS_MEMORY_SLAB__
+#define __TELEIOS_MEMORY_SLAB__
+
+#include "teleios/teleios.h"
+#include "teleios/memory/types.inl"
+
+// ---------------------------------
+// SLAB allocator - page helpers
+// ---------------------------------
+static void* tl_memory_slab_page_alloc(const u32 size) {
+#if defined(TL_PLATFORM_WINDOWS)
+    void* page = _aligned_malloc(size, TL_MEMORY_SLAB_PAGE_SIZE);
+#else
+    void* page = aligned_alloc(TL_MEMORY_SLAB_PAGE_SIZE, size);
+#endif
+    if (page == NULL) TLFATAL("Failed to allocate SLAB page of %u bytes", size)
+    return page;
+}
+
+static void tl_memory_slab_page_free(void* page) {
+#if defined(TL_PLATFORM_WINDOWS)
+    _aligned_free(page);
+#else
+    free(page);
+#endif
+}
+
+static inline TLSlab* tl_memory_slab_header(void* pointer) {
+    return (TLSlab*)((uintptr_t)pointer & ~(uintptr_t)(TL_MEMORY_SLAB_PAGE_SIZE - 1));
+}
+
+// Objects start on a multiple of their size, so the in-page offset indexes them
+static inline u8* tl_memory_slab_tag(TLSlab* slab, void* pointer) {
+    if (slab->size_class == TL_MEMORY_SLAB_CLASS_LARGE) return &slab->tags[0];
+    return &slab->tags[((uintptr_t)pointer & (TL_MEMORY_SLAB_PAGE_SIZE - 1)) / slab->size];
+}
+
+static inline u8 tl_memory_slab_class(const u32 size) {
+    u8 size_class = 0;
+    u32 class_size = TL_MEMORY_SLAB_CLASS_MINIMUM;
+    while (class_size < size) {
+        class_size <<= 1;
+        size_class++;
+    }
+
+    return size_class;
+}
+
+// ---------------------------------
+// SLAB allocator - carve a page into free objects of one class, returns their count
+// ---------------------------------
+static u32 tl_memory_slab_format(TLAllocator* allocator, TLSlab* slab, const u8 size_class) {
+    slab->prev = NULL;
+    slab->next = allocator->slab.slabs;
+    slab->allocator = allocator;
+    slab->size = TL_MEMORY_SLAB_CLASS_MINIMUM << size_class;
+    slab->used = 0;
+    slab->size_class = size_class;
+    allocator->slab.slabs = slab;
+
+    // Objects start on a multiple of their class size, so each one is naturally
+    // aligned to it. The page holds as many objects as with a packed layout.
+    const u32 start = TL_MEMORY_ALIGN_UP(TL_MEMORY_SLAB_HEADER_SIZE, slab->size);
+    const u32 count = (TL_MEMORY_SLAB_PAGE_SIZE - start) / slab->size;
+    u8* first = (u8*)slab + start;
+
+    // Push in reverse so consecutive allocations walk the page forward
+    for (u32 i = count; i > 0; --i) {
+        void** object = (void**)(first + (i - 1) * slab->size);
+        *object = allocator->slab.free_list[size_class];
+        allocator->slab.free_list[size_class] = object;
+    }
+
+    return count;
+}
+
+static void tl_memory_slab_grow(TLAllocator* allocator, const u8 size_class) {
+    TL_PROFILER_PUSH_WITH("0x%p, %u", allocator, size_class)
+
+    const u32 count = tl_memory_slab_format(allocator, tl_memory_slab_page_alloc(TL_MEMORY_SLAB_PAGE_SIZE), size_class);
+    (void)count; // Only traced
+
+    TLVERBOSE("SLAB grow:0x%p class %u bytes, %u objects", allocator, TL_MEMORY_SLAB_CLASS_MINIMUM << size_class, count)
+    TL_PROFILER_POP
+}
+
+// ---------------------------------
+// SLAB allocator - pop up to `count` free objects of one class at once, without
+// growing or tracing each one. Returns how many there were.
+// ---------------------------------
+static u32 tl_memory_slab_carve(TLAllocator* allocator, const u8 size_class, void** objects, const u32 count) {
+    u32 carved = 0;
+    while (carved < count && allocator->slab.free_list[size_class] != NULL) {
+        void* memory = allocator->slab.free_list[size_class];
+        allocator->slab.free_list[size_class] = *(void**)memory;
+        tl_memory_slab_header(memory)->used++;
+        objects[carved++] = memory;
+    }
+
+    allocator->slab.allocation_count += carved;
+    return carved;
+}
+
+// ---------------------------------
+// SLAB allocator - oversize requests get a dedicated block
+// ---------------------------------
+static void* tl_memory_slab_alloc_large(TLAllocator* allocator, const u32 size, const u32 alignment) {
+    TL_PROFILER_PUSH_WITH("0x%p, %u, %u", allocator, size, alignment)
+
+    // The payload must stay inside the first page for the header lookup
+    const u32 start = TL_MEMORY_ALIGN_UP(TL_MEMORY_SLAB_HEADER_SIZE, alignment);
+    const u32 length = TL_MEMORY_ALIGN_UP(start + size, TL_MEMORY_SLAB_PAGE_SIZE);
+    TLSlab* slab = tl_memory_slab_page_alloc(length);
+    slab->prev = NULL;
+    slab->next = allocator->slab.large;
+    slab->allocator = allocator;
+    slab->size = size;
+    slab->used = 1;
+    slab->size_class = TL_MEMORY_SLAB_CLASS_LARGE;
+    if (slab->next != NULL) slab->next->prev = slab;
+    allocator->slab.large = slab;
+
+    void* memory = (u8*)slab + start;
+    TL_PROFILER_POP_WITH(memory)
+}
+
+// ---------------------------------
+// SLAB allocator - pop from the size class free list
+// ---------------------------------
+static void* tl_memory_slab_alloc(TLAllocator* allocator, const TLMemoryTag tag, const u32 size, const u32 alignment) {
+    TL_PROFILER_PUSH_WITH("0x%p, %s, %u, %u", allocator, tl_memory_type_name(tag), size, alignment)
+    if (alignment > TL_MEMORY_SLAB_PAGE_SIZE / 2) {
+        TLFATAL("SLAB allocator supports alignments up to %u bytes, %u requested", TL_MEMORY_SLAB_PAGE_SIZE / 2, alignment)
+    }
+
+    void* memory = NULL;
+    if (size > TL_MEMORY_SLAB_CLASS_MAXIMUM || alignment > TL_MEMORY_SLAB_CLASS_MAXIMUM) {
+        memory = tl_memory_slab_alloc_large(allocator, size, alignment);
+    } else {
+        // Objects are aligned to their class size
+        const u8 size_class = tl_memory_slab_class(size > alignment ? size : alignment);
+        if (allocator->slab.free_list[size_class] == NULL) {
+            tl_memory_slab_grow(allocator, size_class);
+        }
+
+        memory = allocator->slab.free_list[size_class];
+        allocator->slab.free_list[size_class] = *(void**)memory;
+        tl_memory_slab_header(memory)->used++;
+    }
+
+    // Size classes are shared by every tag, remember it for telemetry
+    *tl_memory_slab_tag(tl_memory_slab_header(memory), memory) = (u8)tag;
+
+    allocator->slab.allocation_count++;
+
+    TLVERBOSE("SLAB alloc: %u bytes (ptr=0x%p, total=%u, tag=%s)",
+        size, memory, allocator->slab.allocation_count, tl_memory_type_name(tag));
+
+    TL_PROFILER_POP_WITH(memory)
+}
+
+// ---------------------------------
+// SLAB allocator - keep the object while it fits, NULL when it must move
+// ---------------------------------
+static void* tl_memory_slab_resize(TLAllocator* allocator, void* pointer, const u32 old_size, const u32 new_size) {
+    TL_PROFILER_PUSH_WITH("0x%p, 0x%p, %u, %u", allocator, pointer, old_size, new_size)
+    (void)old_size; // Only traced
+
+    TLSlab* slab = tl_memory_slab_header(pointer);
+    if (slab->allocator != allocator) {
+        TLFATAL("Pointer 0x%p not found in SLAB allocator 0x%p", pointer, allocator);
+    }
+
+    if (slab->size_class == TL_MEMORY_SLAB_CLASS_LARGE) {
+        // The dedicated block is rounded up to whole pages
+        const u32 start = (u32)((u8*)pointer - (u8*)slab);
+        const u32 capacity = TL_MEMORY_ALIGN_UP(start + slab->size, TL_MEMORY_SLAB_PAGE_SIZE) - start;
+        if (new_size > capacity) TL_PROFILER_POP_WITH(NULL)
+        slab->size = new_size;
+    } else if (new_size > slab->size) {
+        TL_PROFILER_POP_WITH(NULL)
+    }
+
+    TL_PROFILER_POP_WITH(pointer)
+}
+
+// ---------------------------------
+// SLAB allocator - push back onto the size class free list
+// ---------------------------------
+static void tl_memory_slab_free(TLAllocator* allocator, void* pointer) {
+    TL_PROFILER_PUSH_WITH("0x%p, 0x%p", allocator, pointer)
+
+    TLSlab* slab = tl_memory_slab_header(pointer);
+    if (slab->allocator != allocator) {
+        TLERROR("Pointer 0x%p not found in SLAB allocator 0x%p", pointer, allocator);
+        TL_PROFILER_POP
+    }
+
+    allocator->slab.allocation_count--;
+
+    if (slab->size_class == TL_MEMORY_SLAB_CLASS_LARGE) {
+        if (slab->prev == NULL) {
+            allocator->slab.large = slab->next;
+        } else {
+            slab->prev->next = slab->next;
+        }
+
+        if (slab->next != NULL) {
+            slab->next->prev = slab->prev;
+        }
+
+        TLVERBOSE("SLAB free: %u bytes (ptr=0x%p, remaining=%u)", slab->size, pointer, allocator->slab.allocation_count);
+
+        // Clear the owner so a stale pointer is rejected instead of corrupting the list
+        slab->allocator = NULL;
+        tl_memory_slab_page_free(slab);
+        TL_PROFILER_POP
+    }
+
+    *(void**)pointer = allocator->slab.free_list[slab->size_class];
+    allocator->slab.free_list[slab->size_class] = pointer;
+    slab->used--;
+
+    TLVERBOSE("SLAB free: %u bytes (ptr=0x%p, remaining=%u)", slab->size, pointer, allocator->slab.allocation_count);
+    TL_PROFILER_POP
+}
+
+// ---------------------------------
+// SLAB allocator - destroy and report leaks
+// ---------------------------------
+static void tl_memory_slab_destroy(TLAllocator* allocator) {
+    TL_PROFILER_PUSH_WITH("0x%p", allocator)
+    if (allocator == NULL) TLFATAL("TLAllocator is NULL")
+
+    u32 leak_count = 0;
+    u32 leaked_bytes = 0;
+
+    TLSlab* slab = allocator->slab.slabs;
+    while (slab != NULL) {
+        if (slab->used > 0) {
+            TLWARN("  Leak: %u objects of %u bytes in slab 0x%p", slab->used, slab->size, slab);
+            leak_count += slab->used;
+            leaked_bytes += slab->used * slab->size;
+        }
+
+        TLSlab* next = slab->next;
+        tl_memory_slab_page_free(slab);
+        slab = next;
+    }
+
+    slab = allocator->slab.large;
+    while (slab != NULL) {
+        TLWARN("  Leak: %u bytes (ptr=0x%p)", slab->size, (u8*)slab + TL_MEMORY_SLAB_HEADER_SIZE);
+        leak_count++;
+        leaked_bytes += slab->size;
+
+        TLSlab* next = slab->next;
+        tl_memory_slab_page_free(slab);
+        slab = next;
+    }
+
+    if (leak_count > 0) {
+        TLERROR("Total memory leaks in allocator 0x%p: %u allocations, %u bytes", allocator, leak_count, leaked_bytes);
+    }
+
+    memset(&allocator->slab, 0, sizeof(allocator->slab));
+    TL_PROFILER_POP
+}
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef __TELEIOS_MEMORY_STACK__
+#define __TELEIOS_MEMORY_STACK__
+
+#include "teleios/teleios.h"
+#include "teleios/memory/types.inl"
+
+// Forward declaration from memory.c
+extern void* tl_malloc(u32 size, const char* error_message);
+
+static inline u8* tl_memory_stack_payload(TLStackChunk* chunk) {
+    return (u8*)chunk + TL_MEMORY_STACK_HEADER_SIZE;
+}
+
+// Offset of the next free byte honoring `alignment` as an absolute address
+static inline u32 tl_memory_stack_offset(TLStackChunk* chunk, const u32 alignment) {
+    const uintptr_t payload = (uintptr_t)tl_memory_stack_payload(chunk);
+    return (u32)(TL_MEMORY_ALIGN_UP(payload + chunk->offset, (uintptr_t)alignment) - payload);
+}
+
+// ---------------------------------
+// STACK allocator - new chunk on top of the current one
+// ---------------------------------
+static TLStackChunk* tl_memory_stack_chunk_create(const u32 size) {
+    TL_PROFILER_PUSH_WITH("%u", size)
+    TLStackChunk* chunk = tl_malloc(TL_MEMORY_STACK_HEADER_SIZE + size, "Failed to allocate TLStackChunk");
+    chunk->prev = NULL;
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->offset = 0;
+    TL_PROFILER_POP_WITH(chunk)
+}
+
+// ---------------------------------
+// STACK allocator - bump, moving up the chunk chain when full
+// ---------------------------------
+static void* tl_memory_stack_alloc(TLAllocator* allocator, const TLMemoryTag tag, const u32 size, const u32 alignment) {
+    TL_PROFILER_PUSH_WITH("0x%p, %s, %u, %u", allocator, tl_memory_type_name(tag), size, alignment)
+    (void)tag; // Only traced
+
+    TLStackChunk* chunk = allocator->stack.current;
+    u32 offset = tl_memory_stack_offset(chunk, alignment);
+
+    if (offset > chunk->size || chunk->size - offset < size) {
+        // Payloads start at the default alignment, anything stricter may need padding
+        const u32 worst_case = size + (alignment - TL_MEMORY_DEFAULT_ALIGNMENT);
+        TLStackChunk* next = chunk->next;
+        if (next == NULL || next->size < worst_case) {
+            // Slot a fresh chunk in between, the retained one stays above for later
+            next = tl_memory_stack_chunk_create(worst_case > allocator->stack.chunk_size ? worst_case : allocator->stack.chunk_size);
+            next->prev = chunk;
+            next->next = chunk->next;
+            if (chunk->next != NULL) chunk->next->prev = next;
+            chunk->next = next;
+            TLVERBOSE("STACK grow:0x%p (chunk=%u bytes)", allocator, next->size)
+        }
+
+        next->offset = 0;
+        allocator->stack.current = next;
+        chunk = next;
+        offset = tl_memory_stack_offset(chunk, alignment);
+    }
+
+    void* memory = tl_memory_stack_payload(chunk) + offset;
+    chunk->offset = offset + size;
+
+    TLVERBOSE("STACK alloc:0x%p used %u with %s, available %u", allocator, size, tl_memory_type_name(tag), chunk->size - chunk->offset)
+    TL_PROFILER_POP_WITH(memory)
+}
+
+// ---------------------------------
+// STACK allocator - grow or shrink the top block in place, NULL when it must move
+// ---------------------------------
+static void* tl_memory_stack_resize(TLAllocator* allocator, void* pointer, const u32 old_size, const u32 new_size) {
+    TL_PROFILER_PUSH_WITH("0x%p, 0x%p, %u, %u", allocator, pointer, old_size, new_size)
+
+    TLStackChunk* chunk = allocator->stack.current;
+    u8* payload = tl_memory_stack_payload(chunk);
+    if ((u8*)pointer + old_size != payload + chunk->offset) {
+        // Not the top block, only a shrink can stay where it is
+        TL_PROFILER_POP_WITH(new_size <= old_size ? pointer : NULL)
+    }
+
+    const u32 offset = (u32)((u8*)pointer - payload);
+    if (chunk->size - offset < new_size) TL_PROFILER_POP_WITH(NULL)
+
+    chunk->offset = offset + new_size;
+
+    TL_PROFILER_POP_WITH(pointer)
+}
+
+// ---------------------------------
+// STACK allocator - rewind to the bottom chunk
+// ---------------------------------
+static void tl_memory_stack_reset(TLAllocator* allocator) {
+    TL_PROFILER_PUSH_WITH("0x%p", allocator)
+
+    TLStackChunk* chunk = allocator->stack.current;
+    while (chunk->prev != NULL) chunk = chunk->prev;
+
+    chunk->offset = 0;
+    allocator->stack.current = chunk;
+
+    TL_PROFILER_POP
+}
+
+// ---------------------------------
+// STACK allocator - destroy every chunk, retained ones included
+// ---------------------------------
+static void tl_memory_stack_destroy(TLAllocator* allocator) {
+    TL_PROFILER_PUSH_WITH("0x%p", allocator)
+    if (allocator == NULL) TLFATAL("TLAllocator is NULL")
+
+    TLStackChunk* chunk = allocator->stack.current;
+    while (chunk->prev != NULL) chunk = chunk->prev;
+
+    while (chunk != NULL) {
+        TLStackChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    allocator->stack.current = NULL;
+    allocator->stack.chunk_size = 0;
+
+    TL_PROFILER_POP
+}
+
+#endif
@@ -0,0 +1,237 @@
+#ifndef __TELEIOS_MEMORY_STATS__
+#define __TELEIOS_MEMORY_STATS__
+
+#include "teleios/teleios.h"
+#include "teleios/memory/types.inl"
+
+static TLMemoryCounter m_tag_counters[TL_MEMORY_MAXIMUM];
+
+// ---------------------------------
+// Counter primitives, returning the live bytes they leave
+// ---------------------------------
+static inline u64 tl_memory_counter_raise(TLMemoryCounter* counter, const u64 bytes) {
+    const u64 current = atomic_fetch_add_explicit(&counter->current, bytes, memory_order_relaxed) + bytes;
+
+    u64 peak = atomic_load_explicit(&counter->peak, memory_order_relaxed);
+    while (current > peak && !atomic_compare_exchange_weak_explicit(&counter->peak, &peak, current, memory_order_relaxed, memory_order_relaxed)) {
+        // peak reloaded by the failed exchange
+    }
+
+    return current;
+}
+
+// Allocators are not thread safe, so their own counters have a single writer
+// and need no read-modify-write, only atomic stores for concurrent readers
+static inline u64 tl_memory_counter_raise_owned(TLMemoryCounter* counter, const u64 bytes) {
+    const u64 current = atomic_load_explicit(&counter->current, memory_order_relaxed) + bytes;
+    atomic_store_explicit(&counter->current, current, memory_order_relaxed);
+    if (current > atomic_load_explicit(&counter->peak, memory_order_relaxed)) {
+        atomic_store_explicit(&counter->peak, current, memory_order_relaxed);
+    }
+
+    return current;
+}
+
+static inline u64 tl_memory_counter_lower_owned(TLMemoryCounter* counter, const u64 bytes) {
+    const u64 current = atomic_load_explicit(&counter->current, memory_order_relaxed) - bytes;
+    atomic_store_explicit(&counter->current, current, memory_order_relaxed);
+    return current;
+}
+
+static inline u64 tl_memory_counter_lower(TLMemoryCounter* counter, const u64 bytes) {
+    return atomic_fetch_sub_explicit(&counter->current, bytes, memory_order_relaxed) - bytes;
+}
+
+static inline void tl_memory_counter_roll(TLMemoryCounter* counter) {
+    const u64 count = atomic_load_explicit(&counter->count, memory_order_relaxed);
+    const u64 mark = atomic_exchange_explicit(&counter->frame_mark, count, memory_order_relaxed);
+    atomic_store_explicit(&counter->frame, count - mark, memory_order_relaxed);
+}
+
+static inline TLMemoryStats tl_memory_counter_snapshot(const TLMemoryCounter* counter) {
+    TLMemoryStats stats;
+    stats.current_bytes = atomic_load_explicit(&counter->current, memory_order_relaxed);
+    stats.peak_bytes = atomic_load_explicit(&counter->peak, memory_order_relaxed);
+    stats.allocation_count = atomic_load_explicit(&counter->count, memory_order_relaxed);
+    stats.frame_allocations = atomic_load_explicit(&counter->frame, memory_order_relaxed);
+    return stats;
+}
+
+// ---------------------------------
+// Budgets
+//
+// The fast path is a load and a compare against the counter value the tracking
+// just produced. Handlers run on the allocating thread, from inside the
+// allocation, and may free (or allocate) memory; nested crossings raised by a
+// handler are not reported again.
+// ---------------------------------
+static TLMemoryBudget m_tag_budgets[TL_MEMORY_MAXIMUM];
+static TL_THREADLOCAL b8 m_budget_dispatching = false;
+
+static void tl_memory_budget_crossed(TLMemoryBudget* budget, const TLMemoryCounter* counter, const TLMemoryTag tag, const TLAllocator* allocator, const u64 current) {
+    if (m_budget_dispatching) return;
+
+    const u64 limit = atomic_load_explicit(&budget->limit, memory_order_relaxed);
+    const b8 over = current > limit;
+    const b8 reported = atomic_exchange_explicit(&budget->pressured, true, memory_order_relaxed);
+    if (!over && reported) return;
+
+    char owner[64];
+    if (allocator == NULL) {
+        snprintf(owner, sizeof(owner), "%s", tl_memory_type_name(tag));
+    } else {
+        snprintf(owner, sizeof(owner), "%s 0x%p", tl_memory_allocator_name(allocator->type), (const void*)allocator);
+    }
+
+    if (over) {
+        TLWARN("Memory budget of %s exceeded: %llu of %llu bytes", owner, current, limit)
+    } else {
+        TLWARN("Memory budget of %s under pressure: %llu of %llu bytes", owner, current, limit)
+    }
+
+    TLEvent event = { 0 };
+    event.u32[0] = allocator == NULL ? (u32)tag : TL_MEMORY_MAXIMUM;
+    event.u32[1] = (u32)(current * 100 / limit);
+    event.u64[1] = (u64)(uintptr_t)allocator;
+
+    m_budget_dispatching = true;
+    tl_event_submit(TL_EVENT_MEMORY_PRESSURE, &event);
+    m_budget_dispatching = false;
+
+    if (over) {
+        const u64 remaining = atomic_load_explicit(&counter->current, memory_order_relaxed);
+        if (remaining > limit) TLFATAL("Memory budget of %s exhausted: %llu of %llu bytes", owner, remaining, limit)
+    }
+}
+
+static inline void tl_memory_budget_raise(TLMemoryBudget* budget, const TLMemoryCounter* counter, const TLMemoryTag tag, const TLAllocator* allocator, const u64 current) {
+    const u64 soft = atomic_load_explicit(&budget->soft, memory_order_relaxed);
+    if (soft != 0 && current >= soft) tl_memory_budget_crossed(budget, counter, tag, allocator, current);
+}
+
+// Re-arms the soft threshold once usage drops back below it
+static inline void tl_memory_budget_lower(TLMemoryBudget* budget, const u64 current) {
+    if (!atomic_load_explicit(&budget->pressured, memory_order_relaxed)) return;
+    if (current < atomic_load_explicit(&budget->soft, memory_order_relaxed)) {
+        atomic_store_explicit(&budget->pressured, false, memory_order_relaxed);
+    }
+}
+
+static inline void tl_memory_budget_set(TLMemoryBudget* budget, const u64 limit, const u8 soft_percent) {
+    const u8 percent = soft_percent == 0 || soft_percent > 100 ? TL_MEMORY_BUDGET_SOFT_DEFAULT : soft_percent;
+    atomic_store_explicit(&budget->limit, limit, memory_order_relaxed);
+    atomic_store_explicit(&budget->soft, limit / 100 * percent + limit % 100 * percent / 100, memory_order_relaxed);
+    atomic_store_explicit(&budget->pressured, false, memory_order_relaxed);
+}
+
+// ---------------------------------
+// Allocation tracking
+//
+// STACK memory is released by rewinding to a marker, which does not say which
+// tags owned it. Its bytes are therefore only tracked on the allocator, the
+// tags still count the allocations.
+//
+// SHARED allocators are used from several threads, so their counters take the
+// read-modify-write path and they keep no per-tag bytes: they are never reset,
+// and whatever is left at destroy is reported as a leak.
+//
+// FRAME allocators also count their bytes per buffer: a reset only recycles
+// the buffer of two frames ago, the previous frame's blocks are still live.
+// ---------------------------------
+static inline void tl_memory_stats_alloc(TLAllocator* allocator, const TLMemoryTag tag, const u32 bytes) {
+    if (allocator->type == TL_ALLOCATOR_SHARED) {
+        atomic_fetch_add_explicit(&allocator->stats.count, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&m_tag_counters[tag].count, 1, memory_order_relaxed);
+        const u64 total = tl_memory_counter_raise(&allocator->stats, bytes);
+        const u64 tagged = tl_memory_counter_raise(&m_tag_counters[tag], bytes);
+        tl_memory_budget_raise(&allocator->budget, &allocator->stats, tag, allocator, total);
+        tl_memory_budget_raise(&m_tag_budgets[tag], &m_tag_counters[tag], tag, NULL, tagged);
+        return;
+    }
+
+    atomic_store_explicit(&allocator->stats.count, atomic_load_explicit(&allocator->stats.count, memory_order_relaxed) + 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&m_tag_counters[tag].count, 1, memory_order_relaxed);
+    const u64 total = tl_memory_counter_raise_owned(&allocator->stats, bytes);
+
+    if (allocator->type != TL_ALLOCATOR_STACK) {
+        const u64 tagged = tl_memory_counter_raise(&m_tag_counters[tag], bytes);
+        allocator->tag_bytes[tag] += bytes;
+        if (allocator->type == TL_ALLOCATOR_FRAME) allocator->frame.tag_bytes[allocator->frame.current][tag] += bytes;
+        tl_memory_budget_raise(&m_tag_budgets[tag], &m_tag_counters[tag], tag, NULL, tagged);
+    }
+
+    tl_memory_budget_raise(&allocator->budget, &allocator->stats, tag, allocator, total);
+}
+
+static inline void tl_memory_stats_free(TLAllocator* allocator, const TLMemoryTag tag, const u32 bytes) {
+    if (allocator->type == TL_ALLOCATOR_SHARED) {
+        tl_memory_budget_lower(&allocator->budget, tl_memory_counter_lower(&allocator->stats, bytes));
+        tl_memory_budget_lower(&m_tag_budgets[tag], tl_memory_counter_lower(&m_tag_counters[tag], bytes));
+        return;
+    }
+
+    tl_memory_budget_lower(&allocator->budget, tl_memory_counter_lower_owned(&allocator->stats, bytes));
+    tl_memory_budget_lower(&m_tag_budgets[tag], tl_memory_counter_lower(&m_tag_counters[tag], bytes));
+    allocator->tag_bytes[tag] -= bytes;
+}
+
+static inline void tl_memory_stats_resize(TLAllocator* allocator, const TLMemoryTag tag, const u32 old_bytes, const u32 new_bytes) {
+    if (allocator->type == TL_ALLOCATOR_SHARED) {
+        tl_memory_stats_free(allocator, tag, old_bytes);
+        const u64 total = tl_memory_counter_raise(&allocator->stats, new_bytes);
+        const u64 tagged = tl_memory_counter_raise(&m_tag_counters[tag], new_bytes);
+        tl_memory_budget_raise(&allocator->budget, &allocator->stats, tag, allocator, total);
+        tl_memory_budget_raise(&m_tag_budgets[tag], &m_tag_counters[tag], tag, NULL, tagged);
+        return;
+    }
+
+    if (new_bytes >= old_bytes) {
+        const u64 total = tl_memory_counter_raise_owned(&allocator->stats, new_bytes - old_bytes);
+        if (allocator->type != TL_ALLOCATOR_STACK) {
+            const u64 tagged = tl_memory_counter_raise(&m_tag_counters[tag], new_bytes - old_bytes);
+            allocator->tag_bytes[tag] += new_bytes - old_bytes;
+            if (allocator->type == TL_ALLOCATOR_FRAME) allocator->frame.tag_bytes[allocator->frame.current][tag] += new_bytes - old_bytes;
+            tl_memory_budget_raise(&m_tag_budgets[tag], &m_tag_counters[tag], tag, NULL, tagged);
+        }
+
+        tl_memory_budget_raise(&allocator->budget, &allocator->stats, tag, allocator, total);
+        return;
+    }
+
+    tl_memory_budget_lower(&allocator->budget, tl_memory_counter_lower_owned(&allocator->stats, old_bytes - new_bytes));
+    if (allocator->type == TL_ALLOCATOR_STACK) return;
+
+    tl_memory_budget_lower(&m_tag_budgets[tag], tl_memory_counter_lower(&m_tag_counters[tag], old_bytes - new_bytes));
+    allocator->tag_bytes[tag] -= old_bytes - new_bytes;
+    if (allocator->type == TL_ALLOCATOR_FRAME) allocator->frame.tag_bytes[allocator->frame.current][tag] -= old_bytes - new_bytes;
+}
+
+// Everything the allocator handed out is gone (reset or destroy)
+static inline void tl_memory_stats_release(TLAllocator* allocator) {
+    for (u32 tag = 0; tag < TL_MEMORY_MAXIMUM; ++tag) {
+        if (allocator->tag_bytes[tag] == 0) continue;
+        tl_memory_budget_lower(&m_tag_budgets[tag], tl_memory_counter_lower(&m_tag_counters[tag], allocator->tag_bytes[tag]));
+        allocator->tag_bytes[tag] = 0;
+    }
+
+    atomic_store_explicit(&allocator->stats.current, 0, memory_order_relaxed);
+    tl_memory_budget_lower(&allocator->budget, 0);
+}
+
+// The FRAME buffer just flipped to is recycled, the other one stays live
+static inline void tl_memory_stats_frame_recycle(TLAllocator* allocator) {
+    u64* recycled = allocator->frame.tag_bytes[allocator->frame.current];
+
+    u64 total = 0;
+    for (u32 tag = 0; tag < TL_MEMORY_MAXIMUM; ++tag) {
+        if (recycled[tag] == 0) continue;
+        tl_memory_budget_lower(&m_tag_budgets[tag], tl_memory_counter_lower(&m_tag_counters[tag], recycled[tag]));
+        allocator->tag_bytes[tag] -= recycled[tag];
+        total += recycled[tag];
+        recycled[tag] = 0;
+    }
+
+    tl_memory_budget_lower(&allocator->budget, tl_memory_counter_lower_owned(&allocator->stats, total));
+}
+
+#endif
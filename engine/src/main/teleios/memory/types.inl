@@ -3,42 +3,220 @@
 
 #include "teleios/teleios.h"
 #include "teleios/profiler/types.inl"
+#include <stdatomic.h>
 
-// Linear allocator structures
-typedef struct {
-    TLMemoryTag tag;
-    void* pointer;
-} TLMemory;
+// Telemetry counters
+//
+// Kept per tag (shared by every allocator and thread) and per allocator. All
+// fields are atomics updated with relaxed ordering: they are statistics, not
+// synchronization, and may be read from any thread while being updated.
+typedef struct TLMemoryCounter {
+    _Atomic u64 current;            // Live bytes
+    _Atomic u64 peak;               // Highest value `current` has reached
+    _Atomic u64 count;              // Allocations since start
+    _Atomic u64 frame_mark;         // `count` when the running frame began
+    _Atomic u64 frame;              // Allocations during the last completed frame
+} TLMemoryCounter;
+
+// Memory budgets
+//
+// A hard limit and the soft threshold below it, in bytes, checked against a
+// telemetry counter (0 = no budget). Crossing the soft threshold submits
+// TL_EVENT_MEMORY_PRESSURE once, until usage drops back below it. Going past the
+// limit submits it every time and is fatal unless the handlers released enough.
+typedef struct TLMemoryBudget {
+    _Atomic u64 limit;
+    _Atomic u64 soft;
+    atomic_bool pressured;          // Soft crossing already reported
+} TLMemoryBudget;
+
+// Soft threshold, in percent of the limit, when none is given
+#define TL_MEMORY_BUDGET_SOFT_DEFAULT 80
 
-typedef struct {
-    char* payload;          // The memory block
-    u32 size;               // The actual memory size
-    u32 index;              // Available memory start position
+// Linear allocator structures
+//
+// Pages form a singly linked list with the payload right after the header.
+// Pages before `current` are used up, `current` is being bumped and the ones
+// after it are either kept from before a reset or dedicated oversized pages.
+typedef struct TLMemoryPage {
+    struct TLMemoryPage* next;  // Next page in the chain
+    u32 size;                   // The actual memory size
+    u32 index;                  // Available memory start position
 } TLMemoryPage;
 
+// Regular pages double in size up to this limit
+#define TL_MEMORY_LINEAR_PAGE_MAXIMUM TL_MEBI_BYTES(16)
+
 // Dynamic allocator structures
+//
+// Every DYNAMIC allocation is a single heap block: the TLDynamicBlock header
+// followed by the payload. The payload pointer handed to the caller sits
+// TL_MEMORY_DYNAMIC_HEADER_SIZE bytes after the header, so tl_memory_free()
+// locates the metadata with pointer arithmetic instead of a list search.
+//
+// Size and tag feed the telemetry and budgets and are always there. The live
+// list, owner and stack trace only exist with TELEIOS_MEMORY_TRACKING.
 typedef struct TLDynamicBlock {
-    void* pointer;
-    struct TLDynamicBlock* next;
-    u32 size;
+#if TELEIOS_MEMORY_TRACKING
+    struct TLDynamicBlock* prev;    // Previous live block (leak tracking)
+    struct TLDynamicBlock* next;    // Next live block (leak tracking)
+    TLAllocator* allocator;         // Owner, used to reject foreign pointers
+#endif
+    u32 size;                       // Payload size in bytes
+    u32 padding;                    // Bytes between the heap block and this header (aligned allocations)
     TLMemoryTag tag;
-#ifdef TELEIOS_BUILD_DEBUG
+#if TELEIOS_MEMORY_TRACKING && defined(TELEIOS_BUILD_DEBUG)
     TLStackTrace stack_trace;
 #endif
 } TLDynamicBlock;
 
+#define TL_MEMORY_DEFAULT_ALIGNMENT (alignof(max_align_t))
+// Moved blocks keep their address alignment up to this many bytes
+#define TL_MEMORY_REALLOC_ALIGNMENT_MAXIMUM 64
+
+#define TL_MEMORY_ALIGN_UP(value, alignment) (((value) + ((alignment) - 1)) & ~((alignment) - 1))
+// Header size rounded up so the payload keeps malloc's alignment guarantee
+#define TL_MEMORY_DYNAMIC_HEADER_SIZE TL_MEMORY_ALIGN_UP(sizeof(TLDynamicBlock), TL_MEMORY_DEFAULT_ALIGNMENT)
+#define TL_MEMORY_LINEAR_HEADER_SIZE TL_MEMORY_ALIGN_UP(sizeof(TLMemoryPage), TL_MEMORY_DEFAULT_ALIGNMENT)
+
+// Slab allocator structures
+//
+// Small requests are rounded up to a power-of-two size class and carved out of
+// page-sized, page-aligned slabs. Each slab starts with a TLSlab header, so the
+// owning slab of any pointer is found by masking the address down to the page.
+// Requests above the largest class get their own page-aligned block with the
+// same header (size_class == TL_MEMORY_SLAB_CLASS_LARGE).
+#define TL_MEMORY_SLAB_PAGE_SIZE 4096
+#define TL_MEMORY_SLAB_CLASS_MINIMUM 16     // Smallest class, must hold a free list link
+#define TL_MEMORY_SLAB_CLASS_COUNT 6        // 16, 32, 64, 128, 256 and 512 bytes
+#define TL_MEMORY_SLAB_CLASS_MAXIMUM (TL_MEMORY_SLAB_CLASS_MINIMUM << (TL_MEMORY_SLAB_CLASS_COUNT - 1))
+#define TL_MEMORY_SLAB_CLASS_LARGE 0xFF
+#define TL_MEMORY_SLAB_OBJECT_MAXIMUM (TL_MEMORY_SLAB_PAGE_SIZE / TL_MEMORY_SLAB_CLASS_MINIMUM)
+
+typedef struct TLSlab {
+    struct TLSlab* prev;            // Previous slab (large blocks only)
+    struct TLSlab* next;            // Next slab of the owning list
+    TLAllocator* allocator;         // Owner, used to reject foreign pointers
+    u32 size;                       // Class size, or payload size for large blocks
+    u16 used;                       // Live objects carved from this slab
+    u8 size_class;                  // Index into the free lists, or TL_MEMORY_SLAB_CLASS_LARGE
+    u8 tags[TL_MEMORY_SLAB_OBJECT_MAXIMUM]; // TLMemoryTag of each object, the first one for large blocks
+} TLSlab;
+
+#define TL_MEMORY_SLAB_HEADER_SIZE TL_MEMORY_ALIGN_UP(sizeof(TLSlab), TL_MEMORY_DEFAULT_ALIGNMENT)
+
+// Stack allocator structures
+//
+// Chunks are chained both ways: rewinding to a marker keeps the chunks above it
+// so the next push reuses them instead of going back to the heap.
+typedef struct TLStackChunk {
+    struct TLStackChunk* prev;      // Chunk below (older)
+    struct TLStackChunk* next;      // Retained chunk above, reused after a rewind
+    u32 size;                       // Payload capacity
+    u32 offset;                     // Bytes used
+} TLStackChunk;
+
+#define TL_MEMORY_STACK_HEADER_SIZE TL_MEMORY_ALIGN_UP(sizeof(TLStackChunk), TL_MEMORY_DEFAULT_ALIGNMENT)
+// Capacity of the per-thread scratch allocator chunks
+#define TL_MEMORY_SCRATCH_SIZE TL_KIBI_BYTES(64)
+
+// Virtual allocator structures
+//
+// One contiguous address range reserved up front and committed on demand, so
+// the arena grows without moving or chaining. The usable base is aligned to a
+// huge page so transparent huge pages can back whole commits.
+#define TL_MEMORY_VIRTUAL_COMMIT_SIZE TL_KIBI_BYTES(64)
+#define TL_MEMORY_VIRTUAL_HUGE_PAGE_SIZE TL_MEBI_BYTES(2)
+
+// Shared allocator structures
+//
+// A SLAB whose objects move between threads in magazines: fixed arrays of free
+// objects of one size class. Every thread keeps two magazines per class (the
+// loaded one and the previous one) and only talks to the depot when both are
+// empty or both are full, so most allocations and frees touch thread-local
+// memory only.
+//
+// The depot owns the backing slabs and the full magazines, behind a spinlock.
+// Full magazines pushed by threads that free more than they allocate (remote
+// frees) and empty magazines left over by refills go to lock-free stacks that
+// are only ever pushed one by one and drained as a whole, so they are not
+// exposed to ABA.
+#define TL_MEMORY_MAGAZINE_SIZE 32          // Objects moved to or from the depot at once
+#define TL_MEMORY_SHARED_MAXIMUM 8          // Shared allocators alive at the same time
+
+typedef struct TLMemoryMagazine {
+    struct TLMemoryMagazine* next;          // Depot list link
+    u32 count;                              // Objects held
+    void* objects[TL_MEMORY_MAGAZINE_SIZE];
+} TLMemoryMagazine;
+
+typedef struct TLMemoryCache {
+    struct TLMemoryCache* next;             // Every cache of the depot, released on destroy
+    TLMemoryMagazine* loaded[TL_MEMORY_SLAB_CLASS_COUNT];
+    TLMemoryMagazine* previous[TL_MEMORY_SLAB_CLASS_COUNT];
+    TLMemoryMagazine* spare;                // Empty magazines taken from the depot in one go
+} TLMemoryCache;
+
+typedef struct TLMemoryDepot {
+    atomic_flag lock;                                               // Guards the slabs, full and caches
+    TLMemoryMagazine* full[TL_MEMORY_SLAB_CLASS_COUNT];             // Magazines ready for a refill
+    _Atomic(TLMemoryMagazine*) returned[TL_MEMORY_SLAB_CLASS_COUNT];// Full magazines pushed lock-free
+    _Atomic(TLMemoryMagazine*) empty;                               // Empty magazines pushed lock-free
+    TLMemoryCache* caches;                                          // One per thread that used the allocator
+    u32 generation;                                                 // Tells a thread's cache slot is stale
+    u8 slot;                                                        // Index of the thread cache slot
+} TLMemoryDepot;
+
+// Frame allocator structures
+//
+// Two equally sized buffers used alternately: resetting at frame start flips to
+// the other buffer and rewinds it, so allocations made during the previous
+// frame stay valid for one more frame (while the graphics thread consumes them).
+
 struct TLAllocator {
     union {
         struct {
-            TLMemoryPage* page;
+            TLMemoryPage* page;         // First page, start of the chain
+            TLMemoryPage* current;      // Page being bumped
+            u32 page_size;              // Size of the next regular page
             u16 page_count;
         } linear;
         struct {
             TLDynamicBlock* head;
             u32 allocation_count;
         } dynamic;
+        struct {
+            void* free_list[TL_MEMORY_SLAB_CLASS_COUNT];   // Free objects, linked through their first word
+            TLSlab* slabs;                                  // Every size-class slab, released on destroy
+            TLSlab* large;                                  // Live oversize blocks
+            u32 allocation_count;
+        } slab;
+        struct {
+            u8* payload;        // Both buffers, back to back
+            u32 size;           // Capacity of each buffer
+            u32 offset;         // Bytes used in the current buffer
+            u32 peak;           // Highest offset reached by any frame
+            u8 current;         // Buffer in use (0 or 1)
+            u64 tag_bytes[2][TL_MEMORY_MAXIMUM];    // Live bytes per buffer and tag, released when the buffer is recycled
+        } frame;
+        struct {
+            TLStackChunk* current;  // Chunk being bumped
+            u32 chunk_size;         // Default capacity of new chunks
+        } stack;
+        struct {
+            u8* mapping;            // Reservation as returned by the platform
+            u8* base;               // First usable byte, huge page aligned
+            u64 reserved;           // Usable bytes from base
+            u64 committed;          // Bytes from base backed by memory
+            u64 offset;             // Bytes handed out
+            b8 huge_pages;          // Commit with MADV_HUGEPAGE
+        } vmem;
     };
     TLAllocatorType type;
+    TLMemoryDepot* depot;                       // SHARED only, the slab fields above are the backing store
+    TLMemoryCounter stats;                      // Bytes and allocations served by this allocator
+    TLMemoryBudget budget;                      // Checked against stats.current
+    u64 tag_bytes[TL_MEMORY_MAXIMUM];           // Live bytes per tag, handed back on reset and destroy
 #if defined(TELEIOS_BUILD_DEBUG)
     TLStackTrace stack_trace;
 #endif
@@ -51,6 +229,7 @@ static inline const char* tl_memory_type_name(const TLMemoryTag tag) {
         case TL_MEMORY_CONTAINER_ITERATOR: return "TL_MEMORY_CONTAINER_ITERATOR";
         case TL_MEMORY_GRAPHICS: return "TL_MEMORY_GRAPHICS";
         case TL_MEMORY_SERIALIZER: return "TL_MEMORY_SERIALIZER";
+        case TL_MEMORY_CONTAINER_ARRAY: return "TL_MEMORY_CONTAINER_ARRAY";
         case TL_MEMORY_CONTAINER_QUEUE: return "TL_MEMORY_CONTAINER_QUEUE";
         case TL_MEMORY_CONTAINER_STACK: return "TL_MEMORY_CONTAINER_STACK";
         case TL_MEMORY_CONTAINER_LIST: return "TL_MEMORY_CONTAINER_LIST";
@@ -73,6 +252,11 @@ static inline const char* tl_memory_allocator_name(const TLAllocatorType type) {
     switch (type) {
         case TL_ALLOCATOR_LINEAR: return "TL_ALLOCATOR_LINEAR";
         case TL_ALLOCATOR_DYNAMIC: return "TL_ALLOCATOR_DYNAMIC";
+        case TL_ALLOCATOR_SLAB: return "TL_ALLOCATOR_SLAB";
+        case TL_ALLOCATOR_FRAME: return "TL_ALLOCATOR_FRAME";
+        case TL_ALLOCATOR_STACK: return "TL_ALLOCATOR_STACK";
+        case TL_ALLOCATOR_VIRTUAL: return "TL_ALLOCATOR_VIRTUAL";
+        case TL_ALLOCATOR_SHARED: return "TL_ALLOCATOR_SHARED";
     }
     return "??";
 }
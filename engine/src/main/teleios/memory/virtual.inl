@@ -0,0 +1,115 @@
+#ifndef __TELEIOS_MEMORY_VIRTUAL__
+#define __TELEIOS_MEMORY_VIRTUAL__
+
+#include "teleios/teleios.h"
+#include "teleios/memory/types.inl"
+
+// ---------------------------------
+// VIRTUAL allocator - reserve the address range
+// ---------------------------------
+static void tl_memory_virtual_create(TLAllocator* allocator, const u64 size) {
+    TL_PROFILER_PUSH_WITH("0x%p, %llu", allocator, size)
+
+    // Over-reserve one huge page so the usable range can start on a boundary
+    const u64 reserved = TL_MEMORY_ALIGN_UP(size, TL_MEMORY_VIRTUAL_HUGE_PAGE_SIZE);
+    u8* mapping = tl_platform_memory_reserve(reserved + TL_MEMORY_VIRTUAL_HUGE_PAGE_SIZE);
+    if (mapping == NULL) TLFATAL("Failed to reserve %llu bytes for VIRTUAL allocator", reserved)
+
+    allocator->vmem.mapping = mapping;
+    allocator->vmem.base = (u8*)TL_MEMORY_ALIGN_UP((uintptr_t)mapping, (uintptr_t)TL_MEMORY_VIRTUAL_HUGE_PAGE_SIZE);
+    allocator->vmem.reserved = reserved;
+
+    TL_PROFILER_POP
+}
+
+// ---------------------------------
+// VIRTUAL allocator - commit the range up to `end`
+// ---------------------------------
+static void tl_memory_virtual_commit(TLAllocator* allocator, const u64 end) {
+    TL_PROFILER_PUSH_WITH("0x%p, %llu", allocator, end)
+
+    const u64 granularity = allocator->vmem.huge_pages ? TL_MEMORY_VIRTUAL_HUGE_PAGE_SIZE : TL_MEMORY_VIRTUAL_COMMIT_SIZE;
+    u64 committed = TL_MEMORY_ALIGN_UP(end, granularity);
+    if (committed > allocator->vmem.reserved) committed = allocator->vmem.reserved;
+
+    if (!tl_platform_memory_commit(allocator->vmem.base + allocator->vmem.committed, committed - allocator->vmem.committed, allocator->vmem.huge_pages)) {
+        TLFATAL("VIRTUAL allocator 0x%p failed to commit up to %llu bytes", allocator, committed)
+    }
+
+    TLVERBOSE("VIRTUAL commit:0x%p %llu -> %llu bytes", allocator, allocator->vmem.committed, committed)
+    allocator->vmem.committed = committed;
+
+    TL_PROFILER_POP
+}
+
+// ---------------------------------
+// VIRTUAL allocator - bump, committing more of the range when needed
+// ---------------------------------
+static void* tl_memory_virtual_alloc(TLAllocator* allocator, const TLMemoryTag tag, const u32 size, const u32 alignment) {
+    TL_PROFILER_PUSH_WITH("0x%p, %s, %u, %u", allocator, tl_memory_type_name(tag), size, alignment)
+
+    const uintptr_t base = (uintptr_t)allocator->vmem.base;
+    const u64 offset = TL_MEMORY_ALIGN_UP(base + allocator->vmem.offset, (uintptr_t)alignment) - base;
+    const u64 end = offset + size;
+    if (end > allocator->vmem.reserved) {
+        TLFATAL("VIRTUAL allocator 0x%p exhausted: %llu of %llu bytes used, %u requested (%s)",
+            allocator, allocator->vmem.offset, allocator->vmem.reserved, size, tl_memory_type_name(tag));
+    }
+
+    if (end > allocator->vmem.committed) {
+        tl_memory_virtual_commit(allocator, end);
+    }
+
+    void* memory = allocator->vmem.base + offset;
+    allocator->vmem.offset = end;
+
+    TLVERBOSE("VIRTUAL alloc:0x%p used %u with %s, committed %llu", allocator, size, tl_memory_type_name(tag), allocator->vmem.committed)
+    TL_PROFILER_POP_WITH(memory)
+}
+
+// ---------------------------------
+// VIRTUAL allocator - grow or shrink the last block in place, NULL when it must move
+// ---------------------------------
+static void* tl_memory_virtual_resize(TLAllocator* allocator, void* pointer, const u32 old_size, const u32 new_size) {
+    TL_PROFILER_PUSH_WITH("0x%p, 0x%p, %u, %u", allocator, pointer, old_size, new_size)
+
+    if ((u8*)pointer + old_size != allocator->vmem.base + allocator->vmem.offset) {
+        // Not the last block, only a shrink can stay where it is
+        TL_PROFILER_POP_WITH(new_size <= old_size ? pointer : NULL)
+    }
+
+    // The range is contiguous, the last block can always grow until it runs out
+    const u64 end = (u64)((u8*)pointer - allocator->vmem.base) + new_size;
+    if (end > allocator->vmem.reserved) TL_PROFILER_POP_WITH(NULL)
+    if (end > allocator->vmem.committed) {
+        tl_memory_virtual_commit(allocator, end);
+    }
+
+    allocator->vmem.offset = end;
+
+    TL_PROFILER_POP_WITH(pointer)
+}
+
+// ---------------------------------
+// VIRTUAL allocator - rewind, keeping the committed pages
+// ---------------------------------
+static void tl_memory_virtual_reset(TLAllocator* allocator) {
+    TL_PROFILER_PUSH_WITH("0x%p", allocator)
+    allocator->vmem.offset = 0;
+    TL_PROFILER_POP
+}
+
+// ---------------------------------
+// VIRTUAL allocator - give the whole range back
+// ---------------------------------
+static void tl_memory_virtual_destroy(TLAllocator* allocator) {
+    TL_PROFILER_PUSH_WITH("0x%p", allocator)
+    if (allocator == NULL) TLFATAL("TLAllocator is NULL")
+
+    tl_platform_memory_release(allocator->vmem.mapping, allocator->vmem.reserved + TL_MEMORY_VIRTUAL_HUGE_PAGE_SIZE);
+    memset(&allocator->vmem, 0, sizeof(allocator->vmem));
+
+    TL_PROFILER_POP
+}
+
+#endif
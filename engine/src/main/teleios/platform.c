@@ -18,8 +18,80 @@
  *
  * Pattern: Compile-time selection → Function pointers → Dispatcher calls
  * This differs from memory.c which uses: Runtime enum → switch/case → Implementation
+ *
+ * The table is filled statically, so dispatchers without state of their own
+ * (virtual memory) already work before tl_platform_initialize().
  */
-static TLPlatform platform = { 0 };
+static TLPlatform platform = {
+#ifdef TL_PLATFORM_LINUX
+    .initialize              = tl_lnx_initialize,
+    .terminate               = tl_lnx_terminate,
+    .time_clock              = tl_lnx_time_clock,
+    .time_local              = tl_lnx_time_local,
+    .time_epoch_millis       = tl_lnx_time_epoch_millis,
+    .time_epoch_micros       = tl_lnx_time_epoch_micros,
+    .time_monotonic_nanos    = tl_lnx_time_monotonic_nanos,
+    .fs_read                 = tl_lnx_filesystem_read,
+    .fs_size                 = tl_lnx_filesystem_size,
+    .fs_exists               = tl_lnx_filesystem_exists,
+    .fs_path_separator       = tl_lnx_filesystem_path_separator,
+    .fs_current_directory    = tl_lnx_filesystem_get_current_directory,
+    .memory_reserve          = tl_lnx_memory_reserve,
+    .memory_commit           = tl_lnx_memory_commit,
+    .memory_release          = tl_lnx_memory_release,
+    .file_map                = tl_lnx_file_map,
+    .file_unmap              = tl_lnx_file_unmap,
+#else
+    .initialize              = tl_winapi_initialize,
+    .terminate               = tl_winapi_terminate,
+    .time_clock              = tl_winapi_time_clock,
+    .time_local              = tl_winapi_time_local,
+    .time_epoch_millis       = tl_winapi_time_epoch_millis,
+    .time_epoch_micros       = tl_winapi_time_epoch_micros,
+    .time_monotonic_nanos    = tl_winapi_time_monotonic_nanos,
+    .fs_read                 = tl_winapi_filesystem_read,
+    .fs_size                 = tl_winapi_filesystem_size,
+    .fs_exists               = tl_winapi_filesystem_exists,
+    .fs_path_separator       = tl_winapi_filesystem_path_separator,
+    .fs_current_directory    = tl_winapi_filesystem_get_current_directory,
+    .memory_reserve          = tl_winapi_memory_reserve,
+    .memory_commit           = tl_winapi_memory_commit,
+    .memory_release          = tl_winapi_memory_release,
+    .file_map                = tl_winapi_file_map,
+    .file_unmap              = tl_winapi_file_unmap,
+#endif
+};
+
+// Lowest level a sink receives, from `property` when present
+static void tl_platform_logging_sink(const char* property, const TLLogSink sink) {
+    if (tl_config_get(property) == NULL) return;
+
+    const TLLogLevel minimum = tl_config_get_log_level(property);
+    for (u32 level = TL_LOG_LEVEL_VERBOSE; level <= TL_LOG_LEVEL_FATAL; ++level) {
+        const u8 sinks = tl_logger_get_sinks((TLLogLevel)level);
+        tl_logger_set_sinks((TLLogLevel)level, level >= minimum ? (u8)(sinks | sink) : (u8)(sinks & ~sink));
+    }
+}
+
+// Applies teleios.logging beyond the level, which the config system sets itself
+static void tl_platform_logging_configure(void) {
+    tl_platform_logging_sink("teleios.logging.console.level", TL_LOG_SINK_CONSOLE);
+    tl_platform_logging_sink("teleios.logging.file.level", TL_LOG_SINK_FILE);
+
+    TLString* file = tl_config_get("teleios.logging.file.path");
+    if (file != NULL) {
+        const u32 megabytes = tl_config_get_u32("teleios.logging.file.megabytes");
+        const u32 rotations = tl_config_get("teleios.logging.file.rotations") != NULL
+            ? tl_config_get_u32("teleios.logging.file.rotations")
+            : 4;
+        tl_logger_file_begin(tl_string_cstr(file), TL_MEBI_BYTES(megabytes > 0 ? megabytes : 16), rotations);
+    }
+
+    if (tl_config_get_b8("teleios.logging.async")) tl_logger_async_begin();
+
+    TLString* binary = tl_config_get("teleios.logging.binary.path");
+    if (binary != NULL) tl_logger_binary_begin(tl_string_cstr(binary));
+}
 
 /**
  * @brief Initialize platform layer
@@ -32,29 +104,6 @@ static TLPlatform platform = { 0 };
  * is the entry point for the entire engine.
  */
 b8 tl_platform_initialize(void) {
-#ifdef TL_PLATFORM_LINUX
-    platform.initialize             = tl_lnx_initialize;
-    platform.terminate              = tl_lnx_terminate;
-    platform.time_clock             = tl_lnx_time_clock;
-    platform.time_epoch_millis      = tl_lnx_time_epoch_millis;
-    platform.time_epoch_micros      = tl_lnx_time_epoch_micros;
-    platform.fs_read                = tl_lnx_filesystem_read;
-    platform.fs_size                = tl_lnx_filesystem_size;
-    platform.fs_exists              = tl_lnx_filesystem_exists;
-    platform.fs_path_separator      = tl_lnx_filesystem_path_separator;
-    platform.fs_current_directory   = tl_lnx_filesystem_get_current_directory;
-#else
-    platform.initialize             = tl_winapi_initialize;
-    platform.terminate              = tl_winapi_terminate;
-    platform.time_clock             = tl_winapi_time_clock;
-    platform.time_epoch_millis      = tl_winapi_time_epoch_millis;
-    platform.time_epoch_micros      = tl_winapi_time_epoch_micros;
-    platform.fs_read                = tl_winapi_filesystem_read;
-    platform.fs_size                = tl_winapi_filesystem_size;
-    platform.fs_exists              = tl_winapi_filesystem_exists;
-    platform.fs_path_separator      = tl_winapi_filesystem_path_separator;
-    platform.fs_current_directory   = tl_winapi_filesystem_get_current_directory;
-#endif
     TL_PROFILER_PUSH
 
     if (!platform.initialize()) {
@@ -72,6 +121,14 @@ b8 tl_platform_initialize(void) {
         TL_PROFILER_POP_WITH(false)
     }
 
+    tl_memory_budget_configure();
+    tl_platform_logging_configure();
+    tl_profiler_thread_name("main");
+    tl_profiler_zones_enable(tl_config_get_b8("teleios.profiler.zones.enabled"));
+
+    TLString* trace = tl_config_get("teleios.profiler.trace.path");
+    if (trace != NULL) tl_profiler_trace_begin(tl_string_cstr(trace));
+
     TLDEBUG("GLFW %s", glfwGetVersionString())
     if (!glfwInit()) {
         TLERROR("GLFW failed to initialize")
@@ -107,6 +164,15 @@ b8 tl_platform_terminate(void) {
     tl_window_terminate();
     glfwTerminate();
 
+    // Every thread is joined, the totals are final
+    tl_mutex_stats_dump();
+    tl_logger_limit_flush();
+
+    // The writer lives on the global allocator, drain it before memory goes away
+    tl_logger_async_end();
+    tl_logger_binary_end();
+    tl_logger_file_end();
+
     if (!tl_config_terminate()) {
         TLERROR("Config system failed to terminate")
         TL_PROFILER_POP_WITH(false)
@@ -117,6 +183,10 @@ b8 tl_platform_terminate(void) {
         TL_PROFILER_POP_WITH(false)
     }
 
+    tl_profiler_stacktrace_release();
+    tl_profiler_trace_end();
+    tl_profiler_zones_release();
+
     if (!platform.terminate()) {
         TLERROR("Platform failed to terminate")
         TL_PROFILER_POP_WITH(false)
@@ -133,6 +203,10 @@ void tl_time_clock(TLDateTime* clock) {
     platform.time_clock(clock);
 }
 
+void tl_time_local(const u64 epoch_millis, TLDateTime* clock) {
+    platform.time_local(epoch_millis, clock);
+}
+
 u64 tl_time_epoch_millis(void) {
     return platform.time_epoch_millis();
 }
@@ -141,6 +215,10 @@ u64 tl_time_epoch_micros(void) {
     return platform.time_epoch_micros();
 }
 
+u64 tl_time_monotonic_nanos(void) {
+    return platform.time_monotonic_nanos();
+}
+
 // ---------------------------------
 // Filesystem API Dispatchers
 // ---------------------------------
@@ -166,4 +244,33 @@ b8 tl_filesystem_exists(const TLString* path) {
 u64 tl_filesystem_size(const TLString* path) {
     if (path == NULL) return 0;
     return platform.fs_size(path);
+}
+
+// ---------------------------------
+// Virtual Memory API Dispatchers
+// ---------------------------------
+
+void* tl_platform_memory_reserve(const u64 size) {
+    if (size == 0) return NULL;
+    return platform.memory_reserve(size);
+}
+
+b8 tl_platform_memory_commit(void* address, const u64 size, const b8 huge_pages) {
+    if (address == NULL || size == 0) return false;
+    return platform.memory_commit(address, size, huge_pages);
+}
+
+void tl_platform_memory_release(void* address, const u64 size) {
+    if (address == NULL) return;
+    platform.memory_release(address, size);
+}
+
+void* tl_platform_file_map(const char* path, const u64 size, void** handle) {
+    if (path == NULL || size == 0 || handle == NULL) return NULL;
+    return platform.file_map(path, size, handle);
+}
+
+void tl_platform_file_unmap(void* address, const u64 size, const u64 used, void* handle) {
+    if (address == NULL) return;
+    platform.file_unmap(address, size, used, handle);
 }
\ No newline at end of file
@@ -9,6 +9,8 @@
 #include <time.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 
 // ---------------------------------
 // Linux Platform - Initialization
@@ -107,6 +109,21 @@ static void tl_lnx_time_clock(TLDateTime* clock) {
     clock->millis = (u16)(now.tv_nsec / 1000000);
 }
 
+static void tl_lnx_time_local(const u64 epoch_millis, TLDateTime* clock) {
+    const time_t seconds = (time_t)(epoch_millis / 1000);
+
+    struct tm localtime = { 0 };
+    if (localtime_r(&seconds, &localtime) == NULL) return;
+
+    clock->year = localtime.tm_year + 1900;
+    clock->month = (u8)(localtime.tm_mon + 1);
+    clock->day = (u8)localtime.tm_mday;
+    clock->hour = (u8)localtime.tm_hour;
+    clock->minute = (u8)localtime.tm_min;
+    clock->second = (u8)localtime.tm_sec;
+    clock->millis = (u16)(epoch_millis % 1000);
+}
+
 static u64 tl_lnx_time_epoch_millis(void) {
     struct timespec now = { 0 };
     clock_gettime(CLOCK_REALTIME_COARSE, &now);  // ~20-30 ns
@@ -119,6 +136,95 @@ static u64 tl_lnx_time_epoch_micros(void) {
     return (u64)now.tv_sec * 1000000 + now.tv_nsec / 1000;
 }
 
+static u64 tl_lnx_time_monotonic_nanos(void) {
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC_RAW, &now);  // Not slewed by NTP
+    return (u64)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+// ---------------------------------
+// Linux Platform - Virtual memory
+// ---------------------------------
+
+static void* tl_lnx_memory_reserve(const u64 size) {
+    // Address space only: nothing is backed until committed
+    void* address = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (address == MAP_FAILED) {
+        TLERROR("Failed to reserve %llu bytes: %s", (unsigned long long)size, strerror(errno));
+        return NULL;
+    }
+
+    return address;
+}
+
+static b8 tl_lnx_memory_commit(void* address, const u64 size, const b8 huge_pages) {
+    if (mprotect(address, size, PROT_READ | PROT_WRITE) != 0) {
+        TLERROR("Failed to commit %llu bytes at 0x%p: %s", (unsigned long long)size, address, strerror(errno));
+        return false;
+    }
+
+#ifdef MADV_HUGEPAGE
+    // Best effort, transparent huge pages may be disabled system-wide
+    if (huge_pages && madvise(address, size, MADV_HUGEPAGE) != 0) {
+        TLWARN("MADV_HUGEPAGE rejected for 0x%p: %s", address, strerror(errno));
+    }
+#else
+    (void)huge_pages;
+#endif
+
+    return true;
+}
+
+static void tl_lnx_memory_release(void* address, const u64 size) {
+    if (munmap(address, size) != 0) {
+        TLERROR("Failed to release %llu bytes at 0x%p: %s", (unsigned long long)size, address, strerror(errno));
+    }
+}
+
+// ---------------------------------
+// Linux Platform - Mapped files
+// ---------------------------------
+
+static void* tl_lnx_file_map(const char* path, const u64 size, void** handle) {
+    const int descriptor = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0) {
+        TLERROR("Failed to open %s: %s", path, strerror(errno));
+        return NULL;
+    }
+
+    // Real blocks up front: a full disk must fail here, not as SIGBUS on a store
+    const int error = posix_fallocate(descriptor, 0, (off_t)size);
+    if (error != 0) {
+        TLERROR("Failed to preallocate %llu bytes for %s: %s", (unsigned long long)size, path, strerror(error));
+        close(descriptor);
+        return NULL;
+    }
+
+    void* address = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    if (address == MAP_FAILED) {
+        TLERROR("Failed to map %s: %s", path, strerror(errno));
+        close(descriptor);
+        return NULL;
+    }
+
+    *handle = (void*)(intptr_t)descriptor;
+    return address;
+}
+
+static void tl_lnx_file_unmap(void* address, const u64 size, const u64 used, void* handle) {
+    const int descriptor = (int)(intptr_t)handle;
+
+    if (munmap(address, size) != 0) {
+        TLERROR("Failed to unmap %llu bytes at 0x%p: %s", (unsigned long long)size, address, strerror(errno));
+    }
+
+    if (ftruncate(descriptor, (off_t)used) != 0) {
+        TLERROR("Failed to truncate a mapped file to %llu bytes: %s", (unsigned long long)used, strerror(errno));
+    }
+
+    close(descriptor);
+}
+
 #endif // TL_PLATFORM_LINUX
 
 #endif // __TELEIOS_PLATFORM_LINUX__
\ No newline at end of file
@@ -21,12 +21,23 @@ typedef struct {
     const char* (*fs_current_directory )(void);
     u64         (*time_epoch_millis     )(void);
     u64         (*time_epoch_micros     )(void);
+    u64         (*time_monotonic_nanos  )(void);
     void        (*time_clock            )(TLDateTime*);
+    void        (*time_local            )(u64, TLDateTime*);
     
     // Filesystem
     TLString*   (*fs_read               )(const TLString*);
     b8          (*fs_exists             )(const TLString*);
     u64         (*fs_size               )(const TLString*);
+
+    // Virtual memory
+    void*       (*memory_reserve        )(u64);
+    b8          (*memory_commit         )(void*, u64, b8);
+    void        (*memory_release        )(void*, u64);
+
+    // Mapped files
+    void*       (*file_map              )(const char*, u64, void**);
+    void        (*file_unmap            )(void*, u64, u64, void*);
 } TLPlatform;
 
 #endif
@@ -136,10 +136,29 @@ static void tl_winapi_time_clock(TLDateTime* clock) {
     clock->millis = (u16)st.wMilliseconds;
 }
 
+static void tl_winapi_time_local(const u64 epoch_millis, TLDateTime* clock) {
+    // FILETIME counts 100 ns intervals since 1601-01-01
+    const u64 ticks = epoch_millis * 10000 + 116444736000000000ULL;
+    FILETIME ft = { .dwLowDateTime = (DWORD)ticks, .dwHighDateTime = (DWORD)(ticks >> 32) };
+
+    SYSTEMTIME utc, st;
+    if (!FileTimeToSystemTime(&ft, &utc)) return;
+    if (!SystemTimeToTzSpecificLocalTime(NULL, &utc, &st)) return;
+
+    clock->year = st.wYear;
+    clock->month = (u8)st.wMonth;
+    clock->day = (u8)st.wDay;
+    clock->hour = (u8)st.wHour;
+    clock->minute = (u8)st.wMinute;
+    clock->second = (u8)st.wSecond;
+    clock->millis = (u16)st.wMilliseconds;
+}
+
 static u64 tl_winapi_time_epoch_millis(void) {
-    LARGE_INTEGER qpc; QueryPerformanceCounter(&qpc);
-    // Shift 30 bits for millis (20 + 10, where 1024 ≈ 1000)
-    return (qpc_epoch_offset >> 10) + ((qpc.QuadPart * qpc_to_micros_mul) >> 30);
+    // Coarse wall clock like CLOCK_REALTIME_COARSE, exact millis and usable before tl_winapi_initialize()
+    FILETIME ft; GetSystemTimeAsFileTime(&ft);
+    const u64 ticks = ((u64)ft.dwHighDateTime << 32) | ft.dwLowDateTime;
+    return (ticks - 116444736000000000ULL) / 10000;
 }
 
 static u64 tl_winapi_time_epoch_micros(void) {
@@ -147,6 +166,93 @@ static u64 tl_winapi_time_epoch_micros(void) {
     return qpc_epoch_offset + ((qpc.QuadPart * qpc_to_micros_mul) >> qpc_to_micros_shift);
 }
 
+static u64 tl_winapi_time_monotonic_nanos(void) {
+    // Usable before tl_winapi_initialize(), the frequency is fixed at boot
+    LARGE_INTEGER freq; QueryPerformanceFrequency(&freq);
+    LARGE_INTEGER qpc; QueryPerformanceCounter(&qpc);
+    const u64 seconds = (u64)qpc.QuadPart / (u64)freq.QuadPart;
+    const u64 remainder = (u64)qpc.QuadPart % (u64)freq.QuadPart;
+    return seconds * 1000000000ULL + remainder * 1000000000ULL / (u64)freq.QuadPart;
+}
+
+// ---------------------------------
+// Windows Platform - Virtual memory
+// ---------------------------------
+
+static void* tl_winapi_memory_reserve(const u64 size) {
+    void* address = VirtualAlloc(NULL, (SIZE_T)size, MEM_RESERVE, PAGE_NOACCESS);
+    if (address == NULL) {
+        TLERROR("Failed to reserve %llu bytes: error %lu", (unsigned long long)size, GetLastError());
+    }
+
+    return address;
+}
+
+static b8 tl_winapi_memory_commit(void* address, const u64 size, const b8 huge_pages) {
+    // Large pages need SeLockMemoryPrivilege and cannot be committed piecemeal
+    (void)huge_pages;
+
+    if (VirtualAlloc(address, (SIZE_T)size, MEM_COMMIT, PAGE_READWRITE) == NULL) {
+        TLERROR("Failed to commit %llu bytes at 0x%p: error %lu", (unsigned long long)size, address, GetLastError());
+        return false;
+    }
+
+    return true;
+}
+
+static void tl_winapi_memory_release(void* address, const u64 size) {
+    (void)size; // MEM_RELEASE frees the whole reservation
+    if (!VirtualFree(address, 0, MEM_RELEASE)) {
+        TLERROR("Failed to release 0x%p: error %lu", address, GetLastError());
+    }
+}
+
+// ---------------------------------
+// Windows Platform - Mapped files
+// ---------------------------------
+
+static void* tl_winapi_file_map(const char* path, const u64 size, void** handle) {
+    HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        TLERROR("Failed to open %s: error %lu", path, GetLastError());
+        return NULL;
+    }
+
+    // Sizing the mapping extends the file to `size`
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE, (DWORD)(size >> 32), (DWORD)size, NULL);
+    if (mapping == NULL) {
+        TLERROR("Failed to map %s: error %lu", path, GetLastError());
+        CloseHandle(file);
+        return NULL;
+    }
+
+    void* address = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, (SIZE_T)size);
+    CloseHandle(mapping); // The view keeps the mapping alive
+    if (address == NULL) {
+        TLERROR("Failed to map a view of %s: error %lu", path, GetLastError());
+        CloseHandle(file);
+        return NULL;
+    }
+
+    *handle = file;
+    return address;
+}
+
+static void tl_winapi_file_unmap(void* address, const u64 size, const u64 used, void* handle) {
+    (void)size; // The whole view goes
+    if (!UnmapViewOfFile(address)) {
+        TLERROR("Failed to unmap 0x%p: error %lu", address, GetLastError());
+    }
+
+    LARGE_INTEGER end;
+    end.QuadPart = (LONGLONG)used;
+    if (!SetFilePointerEx(handle, end, NULL, FILE_BEGIN) || !SetEndOfFile(handle)) {
+        TLERROR("Failed to truncate a mapped file to %llu bytes: error %lu", (unsigned long long)used, GetLastError());
+    }
+
+    CloseHandle(handle);
+}
+
 #endif // TL_PLATFORM_WINDOWS
 
 #endif // __TELEIOS_PLATFORM_WINDOWS__
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include "teleios/teleios.h"
+#include "logger/arguments.inl"
 #include "profiler/types.inl"
+#include "profiler/zone.inl"
+#include "profiler/phase.inl"
 
 // Thread-local profiler state
 static TL_THREADLOCAL u16 tl_profiler_frame_index = U16_MAX;
@@ -16,38 +19,172 @@ void tl_profiler_frame_push(const char* filename, const u32 lineno, const char*
         exit(99);
     }
 
-    tl_profiler_frames[tl_profiler_frame_index].filename = filename;
-    tl_profiler_frames[tl_profiler_frame_index].function = function;
-    tl_profiler_frames[tl_profiler_frame_index].lineno = lineno;
+    TLStackFrame* frame = &tl_profiler_frames[tl_profiler_frame_index];
+    frame->filename = filename;
+    frame->function = function;
+    frame->lineno = lineno;
+    frame->format = arguments;
+    frame->argc = 0;
 
-    if (TL_LIKELY(arguments == NULL)) {
-        tl_profiler_frames[tl_profiler_frame_index].arguments[0] = '\0';
-    } else {
-        va_list arg_ptr;
-        va_start(arg_ptr, arguments);
-        vsnprintf(tl_profiler_frames[tl_profiler_frame_index].arguments, TL_PROFILER_FRAME_ARGUMENTS_SIZE, arguments, arg_ptr);
-        va_end(arg_ptr);
-    }
+    if (TL_LIKELY(arguments == NULL)) return;
+
+    // Only the words are copied, formatting waits for a snapshot that needs the text
+    va_list arg_ptr;
+    va_start(arg_ptr, arguments);
+    for (const char* c = arguments; *c != '\0' && frame->argc < TL_PROFILER_FRAME_ARGUMENTS_MAXIMUM; ) {
+        if (*c++ != '%') continue;
 
-    // tl_logger_write(TL_LOG_LEVEL_VERBOSE, filename, lineno, "[in ] %s(%s)",
-    //                 function, tl_profiler_frames[tl_profiler_frame_index].arguments);
+        TLLogArgument kind;
+        c = tl_logger_argument_parse(c, &kind);
+        if (kind == TL_LOG_ARGUMENT_NONE) continue;
+        if (kind == TL_LOG_ARGUMENT_UNSUPPORTED) break;
+
+        const u64 word = tl_logger_argument_word(kind, &arg_ptr);
+        frame->arguments[frame->argc++] = word;
+    }
+    va_end(arg_ptr);
 }
 
 /**
  * @brief Pop current frame from call stack and log exit
  */
 void tl_profiler_frame_pop(void) {
-    // tl_logger_write(TL_LOG_LEVEL_VERBOSE,
-    //                 tl_profiler_frames[tl_profiler_frame_index].filename,
-    //                 tl_profiler_frames[tl_profiler_frame_index].lineno,
-    //                 "[out] %s(%s)",
-    //                 tl_profiler_frames[tl_profiler_frame_index].function,
-    //                 tl_profiler_frames[tl_profiler_frame_index].arguments
-    // );
-    memset(&tl_profiler_frames[tl_profiler_frame_index], 0, sizeof(TLStackFrame));
     tl_profiler_frame_index--;
 }
 
+// Strings are read now, so they must still be alive: the frame that received them still is.
+static void tl_profiler_frame_format(const TLStackFrame* frame, char* buffer, const u32 size) {
+    tl_logger_argument_replay(frame->format, frame->arguments, frame->argc, buffer, size);
+}
+
+// ---------------------------------
+// Interned stack traces, shared by every thread
+// ---------------------------------
+static atomic_flag m_stacktrace_lock = ATOMIC_FLAG_INIT;
+static atomic_bool m_stacktrace_arguments = false;
+static TLStackRecord* m_stacktrace_records = NULL;
+static u32 m_stacktrace_count = 0;
+static u32 m_stacktrace_capacity = 0;
+static u32* m_stacktrace_index = NULL;          // Record id per slot, 0 when empty
+static u32 m_stacktrace_index_size = 0;
+
+static void tl_profiler_stacktrace_lock(void) {
+    while (atomic_flag_test_and_set_explicit(&m_stacktrace_lock, memory_order_acquire)) {
+        // Held only for a probe or an insert
+    }
+}
+
+static void tl_profiler_stacktrace_unlock(void) {
+    atomic_flag_clear_explicit(&m_stacktrace_lock, memory_order_release);
+}
+
+static void* tl_profiler_stacktrace_malloc(const u64 size) {
+    void* memory = malloc(size);
+    if (memory == NULL) {
+        tl_logger_write(TL_LOG_LEVEL_FATAL, __FILE__, __LINE__, "Failed to allocate %llu bytes for the stack trace table", size);
+        exit(99);
+    }
+
+    return memory;
+}
+
+// `arguments` holds `depth` formatted frames, NULL when they are not kept
+static u64 tl_profiler_stacktrace_hash(const u16 depth, const char* arguments) {
+    u64 hash = 14695981039346656037ULL;
+    for (u16 i = 0; i < depth; i++) {
+        const TLStackFrame* frame = &tl_profiler_frames[i];
+        const u64 words[3] = { (u64)(uintptr_t)frame->filename, (u64)(uintptr_t)frame->function, frame->lineno };
+        for (u32 w = 0; w < 3; w++) {
+            hash ^= words[w];
+            hash *= 1099511628211ULL;
+        }
+
+        if (arguments != NULL) {
+            for (const char* c = arguments + (u64)i * TL_PROFILER_FRAME_ARGUMENTS_SIZE; *c != '\0'; c++) {
+                hash ^= (u8)*c;
+                hash *= 1099511628211ULL;
+            }
+        }
+    }
+
+    return hash ^ depth;
+}
+
+static b8 tl_profiler_stacktrace_matches(const TLStackRecord* record, const u64 hash, const u16 depth, const char* arguments) {
+    if (record->hash != hash || record->depth != depth) return false;
+    if ((record->arguments != NULL) != (arguments != NULL)) return false;
+
+    for (u16 i = 0; i < depth; i++) {
+        const TLStackFrame* frame = &tl_profiler_frames[i];
+        const TLStackSite* site = &record->sites[i];
+        if (site->filename != frame->filename || site->function != frame->function || site->lineno != frame->lineno) return false;
+        const u64 offset = (u64)i * TL_PROFILER_FRAME_ARGUMENTS_SIZE;
+        if (arguments != NULL && strcmp(record->arguments + offset, arguments + offset) != 0) return false;
+    }
+
+    return true;
+}
+
+static void tl_profiler_stacktrace_index_grow(void) {
+    const u32 size = m_stacktrace_index_size == 0 ? TL_PROFILER_STACKTRACE_INDEX_INITIAL : m_stacktrace_index_size * 2;
+    u32* index = tl_profiler_stacktrace_malloc(sizeof(u32) * size);
+    memset(index, 0, sizeof(u32) * size);
+
+    for (u32 id = 1; id <= m_stacktrace_count; id++) {
+        u32 slot = (u32)m_stacktrace_records[id - 1].hash & (size - 1);
+        while (index[slot] != 0) slot = (slot + 1) & (size - 1);
+        index[slot] = id;
+    }
+
+    free(m_stacktrace_index);
+    m_stacktrace_index = index;
+    m_stacktrace_index_size = size;
+}
+
+// Copies the live frames into a new record, the lock must be held
+static u32 tl_profiler_stacktrace_intern(const u64 hash, const u16 depth, const char* arguments) {
+    if (m_stacktrace_count == m_stacktrace_capacity) {
+        m_stacktrace_capacity = m_stacktrace_capacity == 0 ? 256 : m_stacktrace_capacity * 2;
+        TLStackRecord* records = realloc(m_stacktrace_records, sizeof(TLStackRecord) * m_stacktrace_capacity);
+        if (records == NULL) {
+            tl_logger_write(TL_LOG_LEVEL_FATAL, __FILE__, __LINE__, "Failed to grow the stack trace table");
+            exit(99);
+        }
+
+        m_stacktrace_records = records;
+    }
+
+    TLStackRecord* record = &m_stacktrace_records[m_stacktrace_count];
+    record->hash = hash;
+    record->depth = depth;
+    record->sites = tl_profiler_stacktrace_malloc(sizeof(TLStackSite) * depth);
+    record->arguments = NULL;
+    if (arguments != NULL) {
+        record->arguments = tl_profiler_stacktrace_malloc((u64)TL_PROFILER_FRAME_ARGUMENTS_SIZE * depth);
+        memcpy(record->arguments, arguments, (u64)TL_PROFILER_FRAME_ARGUMENTS_SIZE * depth);
+    }
+
+    for (u16 i = 0; i < depth; i++) {
+        const TLStackFrame* frame = &tl_profiler_frames[i];
+        record->sites[i].filename = frame->filename;
+        record->sites[i].function = frame->function;
+        record->sites[i].lineno = frame->lineno;
+    }
+
+    const u32 id = ++m_stacktrace_count;
+
+    // Keep the index at most half full
+    if (m_stacktrace_count * 2 > m_stacktrace_index_size) {
+        tl_profiler_stacktrace_index_grow();
+    } else {
+        u32 slot = (u32)hash & (m_stacktrace_index_size - 1);
+        while (m_stacktrace_index[slot] != 0) slot = (slot + 1) & (m_stacktrace_index_size - 1);
+        m_stacktrace_index[slot] = id;
+    }
+
+    return id;
+}
+
 /**
  * @brief Capture current call stack
  */
@@ -56,48 +193,114 @@ void tl_profiler_stacktrace_snapshot(TLStackTrace* trace) {
         return;
     }
 
-    memset(trace, 0, sizeof(TLStackTrace));
+    // The frame index wraps to U16_MAX when nothing has been pushed
+    const u16 depth = tl_profiler_frame_index == U16_MAX ? 0 : tl_profiler_frame_index + 1;
+    trace->depth = depth;
+    trace->id = 0;
+    if (depth == 0) {
+        return;
+    }
 
-    // Capture up to TL_STACKTRACE_MAX_DEPTH frames from the current call stack
-    const u16 max_frames = (tl_profiler_frame_index + 1 < TELEIOS_FRAME_MAXIMUM) ? tl_profiler_frame_index + 1 : TELEIOS_FRAME_MAXIMUM;
+    // Arguments are formatted here, and only when they are kept
+    char* arguments = NULL;
+    if (atomic_load_explicit(&m_stacktrace_arguments, memory_order_relaxed)) {
+        arguments = tl_profiler_stacktrace_malloc((u64)TL_PROFILER_FRAME_ARGUMENTS_SIZE * depth);
+        for (u16 i = 0; i < depth; i++) {
+            tl_profiler_frame_format(&tl_profiler_frames[i], arguments + (u64)i * TL_PROFILER_FRAME_ARGUMENTS_SIZE, TL_PROFILER_FRAME_ARGUMENTS_SIZE);
+        }
+    }
 
-    for (u16 i = 0; i < max_frames; i++) {
-        const TLStackFrame* source = &tl_profiler_frames[i];
-        TLStackFrame* dest = &trace->frames[i];
+    const u64 hash = tl_profiler_stacktrace_hash(depth, arguments);
 
-        dest->filename = source->filename;
-        dest->function = source->function;
-        dest->lineno = source->lineno;
+    tl_profiler_stacktrace_lock();
 
-        // Copy arguments
-        memcpy(dest->arguments, source->arguments, TL_PROFILER_FRAME_ARGUMENTS_SIZE);
+    if (m_stacktrace_index != NULL) {
+        u32 slot = (u32)hash & (m_stacktrace_index_size - 1);
+        while (m_stacktrace_index[slot] != 0) {
+            const u32 id = m_stacktrace_index[slot];
+            if (tl_profiler_stacktrace_matches(&m_stacktrace_records[id - 1], hash, depth, arguments)) {
+                trace->id = id;
+                tl_profiler_stacktrace_unlock();
+                free(arguments);
+                return;
+            }
+
+            slot = (slot + 1) & (m_stacktrace_index_size - 1);
+        }
     }
 
-    trace->depth = max_frames;
+    trace->id = tl_profiler_stacktrace_intern(hash, depth, arguments);
+    tl_profiler_stacktrace_unlock();
+    free(arguments);
 }
 
 /**
  * @brief Print a captured stack trace to the logger
  */
 void tl_profiler_stacktrace_print(const TLStackTrace* trace) {
-    if (trace == NULL || trace->depth == 0) {
+    if (trace == NULL || trace->id == 0) {
         tl_logger_write(TL_LOG_LEVEL_WARN, __FILE__, __LINE__, "  (no stack trace available)");
         return;
     }
 
-    tl_logger_write(TL_LOG_LEVEL_WARN, __FILE__, __LINE__, "  Stack trace (%u frames):", trace->depth);
+    // Records move when the table grows, their sites and arguments do not
+    tl_profiler_stacktrace_lock();
+    const TLStackRecord record = m_stacktrace_records[trace->id - 1];
+    tl_profiler_stacktrace_unlock();
 
-    for (u16 i = 0; i < trace->depth; i++) {
-        const TLStackFrame* frame = &trace->frames[i];
+    tl_logger_write(TL_LOG_LEVEL_WARN, __FILE__, __LINE__, "  Stack trace (%u frames):", record.depth);
+
+    for (u16 i = 0; i < record.depth; i++) {
+        const TLStackSite* site = &record.sites[i];
 
         // Extract just the filename (not full path)
-        const char* filename = strrchr(frame->filename, tl_filesystem_path_separator());
-        filename = (filename == NULL) ? frame->filename : filename + 1;
+        const char* filename = strrchr(site->filename, tl_filesystem_path_separator());
+        filename = (filename == NULL) ? site->filename : filename + 1;
 
-        if (frame->arguments[0] != '\0') {
-            tl_logger_write(TL_LOG_LEVEL_WARN, __FILE__, __LINE__, "    #%02d: %20s:%04d %s(%s)", i, filename, frame->lineno, frame->function, frame->arguments);
+        const char* arguments = record.arguments == NULL ? "" : record.arguments + (u64)i * TL_PROFILER_FRAME_ARGUMENTS_SIZE;
+        if (arguments[0] != '\0') {
+            tl_logger_write(TL_LOG_LEVEL_WARN, __FILE__, __LINE__, "    #%02d: %20s:%04d %s(%s)", i, filename, site->lineno, site->function, arguments);
         } else {
-            tl_logger_write(TL_LOG_LEVEL_WARN, __FILE__, __LINE__, "    #%02d: %20s:%04d %s", i, filename, frame->lineno, frame->function);
+            tl_logger_write(TL_LOG_LEVEL_WARN, __FILE__, __LINE__, "    #%02d: %20s:%04d %s", i, filename, site->lineno, site->function);
         }
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Keep frame arguments in captured stack traces
+ */
+void tl_profiler_stacktrace_keep_arguments(const b8 enabled) {
+    atomic_store_explicit(&m_stacktrace_arguments, enabled, memory_order_relaxed);
+}
+
+/**
+ * @brief Number of distinct stack traces captured so far
+ */
+u32 tl_profiler_stacktrace_count(void) {
+    tl_profiler_stacktrace_lock();
+    const u32 count = m_stacktrace_count;
+    tl_profiler_stacktrace_unlock();
+    return count;
+}
+
+/**
+ * @brief Release every interned stack trace
+ */
+void tl_profiler_stacktrace_release(void) {
+    tl_profiler_stacktrace_lock();
+
+    for (u32 i = 0; i < m_stacktrace_count; i++) {
+        free(m_stacktrace_records[i].sites);
+        free(m_stacktrace_records[i].arguments);
+    }
+
+    free(m_stacktrace_records);
+    free(m_stacktrace_index);
+    m_stacktrace_records = NULL;
+    m_stacktrace_index = NULL;
+    m_stacktrace_count = 0;
+    m_stacktrace_capacity = 0;
+    m_stacktrace_index_size = 0;
+
+    tl_profiler_stacktrace_unlock();
+}
@@ -0,0 +1,105 @@
+#ifndef __TELEIOS_PROFILER_PHASE__
+#define __TELEIOS_PROFILER_PHASE__
+
+#include "teleios/teleios.h"
+#include "teleios/profiler/types.inl"
+
+// Written and read by the main thread only
+static TLProfilerPhaseHistogram m_phases[TL_PROFILER_PHASE_MAXIMUM];
+
+static const char* m_phase_names[TL_PROFILER_PHASE_MAXIMUM] = {
+    "frame", "frame_begin", "step", "update", "frame_end", "input", "events"
+};
+
+static inline u32 tl_profiler_phase_bucket(const u64 nanos) {
+    if (nanos < (1ULL << TL_PROFILER_PHASE_SUB_BITS)) return (u32)nanos;
+
+    // A handful of samples per frame, no need for a compiler intrinsic
+    u32 exponent = 0;
+    for (u64 value = nanos; value > 1; value >>= 1) exponent++;
+    if (exponent > TL_PROFILER_PHASE_EXPONENT_MAXIMUM) return TL_PROFILER_PHASE_BUCKETS - 1;
+
+    const u32 sub = (u32)(nanos >> (exponent - TL_PROFILER_PHASE_SUB_BITS)) & ((1u << TL_PROFILER_PHASE_SUB_BITS) - 1);
+    return ((exponent - TL_PROFILER_PHASE_SUB_BITS + 1) << TL_PROFILER_PHASE_SUB_BITS) + sub;
+}
+
+// Largest value that lands in the bucket
+static inline u64 tl_profiler_phase_bucket_limit(const u32 bucket) {
+    if (bucket < (1u << TL_PROFILER_PHASE_SUB_BITS)) return bucket;
+
+    const u32 exponent = (bucket >> TL_PROFILER_PHASE_SUB_BITS) + TL_PROFILER_PHASE_SUB_BITS - 1;
+    const u64 sub = bucket & ((1u << TL_PROFILER_PHASE_SUB_BITS) - 1);
+    const u64 width = 1ULL << (exponent - TL_PROFILER_PHASE_SUB_BITS);
+    return (((1ULL << TL_PROFILER_PHASE_SUB_BITS) + sub) << (exponent - TL_PROFILER_PHASE_SUB_BITS)) + width - 1;
+}
+
+const char* tl_profiler_phase_name(const TLProfilerPhase phase) {
+    if (phase >= TL_PROFILER_PHASE_MAXIMUM) return "unknown";
+    return m_phase_names[phase];
+}
+
+void tl_profiler_phase_record(const TLProfilerPhase phase, const u64 nanos) {
+    if (phase >= TL_PROFILER_PHASE_MAXIMUM) return;
+
+    TLProfilerPhaseHistogram* histogram = &m_phases[phase];
+    histogram->buckets[tl_profiler_phase_bucket(nanos)]++;
+    histogram->samples++;
+    if (nanos > histogram->maximum) histogram->maximum = nanos;
+}
+
+void tl_profiler_phase_stats(const TLProfilerPhase phase, TLProfilerPhaseStats* stats) {
+    if (stats == NULL) return;
+    memset(stats, 0, sizeof(TLProfilerPhaseStats));
+    if (phase >= TL_PROFILER_PHASE_MAXIMUM) return;
+
+    const TLProfilerPhaseHistogram* histogram = &m_phases[phase];
+    if (histogram->samples == 0) return;
+
+    stats->samples = histogram->samples;
+    stats->maximum = histogram->maximum;
+
+    // Nearest rank: the smallest value with at least p% of the samples at or below it
+    const u64 ranks[3] = {
+        (histogram->samples * 50 + 99) / 100,
+        (histogram->samples * 95 + 99) / 100,
+        (histogram->samples * 99 + 99) / 100
+    };
+    u64* percentiles[3] = { &stats->p50, &stats->p95, &stats->p99 };
+
+    u64 seen = 0;
+    u32 next = 0;
+    for (u32 bucket = 0; bucket < TL_PROFILER_PHASE_BUCKETS && next < 3; ++bucket) {
+        seen += histogram->buckets[bucket];
+        while (next < 3 && seen >= ranks[next]) {
+            const u64 limit = tl_profiler_phase_bucket_limit(bucket);
+            *percentiles[next++] = limit < histogram->maximum ? limit : histogram->maximum;
+        }
+    }
+}
+
+void tl_profiler_phase_reset(void) {
+    memset(m_phases, 0, sizeof(m_phases));
+}
+
+void tl_profiler_phase_dump(void) {
+    char line[1024];
+    i32 written = snprintf(line, sizeof(line), "Frame ms p50/p95/p99/max:");
+
+    for (u32 phase = 0; phase < TL_PROFILER_PHASE_MAXIMUM && written > 0 && written < (i32)sizeof(line); ++phase) {
+        TLProfilerPhaseStats stats;
+        tl_profiler_phase_stats(phase, &stats);
+        if (stats.samples == 0) continue;
+
+        written += snprintf(line + written, sizeof(line) - (u64)written, " %s %.2f/%.2f/%.2f/%.2f",
+            m_phase_names[phase],
+            (f64)stats.p50 / 1000000.0,
+            (f64)stats.p95 / 1000000.0,
+            (f64)stats.p99 / 1000000.0,
+            (f64)stats.maximum / 1000000.0);
+    }
+
+    TLINFO("%s", line)
+    tl_profiler_phase_reset();
+}
+
+#endif
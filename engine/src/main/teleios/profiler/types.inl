@@ -2,6 +2,7 @@
 #define __TELEIOS_PROFILER_TYPES__
 
 #include "teleios/defines.h"
+#include <stdatomic.h>
 
 
 #if ! defined(TELEIOS_FRAME_MAXIMUM)
@@ -12,16 +13,92 @@
 #   define TL_PROFILER_FRAME_ARGUMENTS_SIZE 1024
 #endif
 
+// Raw words kept per frame, extra arguments are dropped from the text
+#if ! defined(TL_PROFILER_FRAME_ARGUMENTS_MAXIMUM)
+#   define TL_PROFILER_FRAME_ARGUMENTS_MAXIMUM 8
+#endif
+
+// Frames keep the format and the raw argument words: the text is only built
+// when a snapshot keeps arguments, see tl_profiler_frame_format().
 typedef struct  {
     const char* filename;
     const char* function;
     u32 lineno;
-    char arguments[TL_PROFILER_FRAME_ARGUMENTS_SIZE];
+    u8 argc;
+    const char* format;                                 // NULL when the frame has no arguments
+    u64 arguments[TL_PROFILER_FRAME_ARGUMENTS_MAXIMUM]; // Integers widened, doubles by their bits
 } TLStackFrame;
 
+// Captured call stacks are interned: identical stacks share one TLStackRecord
+// and a TLStackTrace only carries its id, so a snapshot costs a hash and a
+// table probe instead of copying every frame.
 struct  TLStackTrace {
-    TLStackFrame frames[TELEIOS_FRAME_MAXIMUM];
+    u32 id;             // Interned record, 0 when nothing was captured
     u16 depth;
 } ;
 
+typedef struct {
+    const char* filename;
+    const char* function;
+    u32 lineno;
+} TLStackSite;
+
+typedef struct {
+    u64 hash;
+    u16 depth;
+    TLStackSite* sites;     // `depth` entries, outermost first
+    char* arguments;        // `depth` strings of TL_PROFILER_FRAME_ARGUMENTS_SIZE, only when requested
+} TLStackRecord;
+
+// Open addressing index over the records, must stay a power of two
+#define TL_PROFILER_STACKTRACE_INDEX_INITIAL 1024
+
+// Timed zones
+//
+// Every thread records into its own ring buffer, so recording takes no lock:
+// the owner is the only writer and publishes each record by bumping `head`.
+// The collector copies records between `tail` and `head` and then re-reads
+// `head` to drop the ones the owner may have overwritten meanwhile. Fields are
+// relaxed atomics so the copy never reads a torn value.
+#if ! defined(TL_PROFILER_ZONE_RING_SIZE)
+#   define TL_PROFILER_ZONE_RING_SIZE 16384     // Records per thread, must be a power of two
+#endif
+
+typedef struct {
+    _Atomic(const TLProfilerZone*) zone;
+    _Atomic u64 begin;                          // Ticks, see tl_profiler_zone_ticks()
+    _Atomic u64 end;                            // Ticks, 0 for instant events and counters
+    _Atomic u64 value;                          // Instant events and counters
+} TLProfilerZoneRecord;
+
+#define TL_PROFILER_THREAD_NAME_SIZE 32
+
+typedef struct TLProfilerZoneRing {
+    struct TLProfilerZoneRing* next;            // Every ring ever created, released on terminate
+    u64 thread;                                 // Owner
+    char name[TL_PROFILER_THREAD_NAME_SIZE];    // Set by tl_profiler_thread_name(), empty otherwise
+    _Atomic u64 head;                           // Records written, owner only
+    u64 tail;                                   // Records collected, collector only
+    TLProfilerZoneRecord records[TL_PROFILER_ZONE_RING_SIZE];
+} TLProfilerZoneRing;
+
+// Zones aggregated by tl_profiler_zones_dump(), must stay a power of two
+#define TL_PROFILER_ZONE_SUMMARY_SIZE 256
+
+// Frame statistics
+//
+// Log-linear histogram: values below 16 ns get a bucket each, every power of
+// two above is split in 16 buckets, so a bucket is at most 1/16 wide. The
+// exponent stops at 2^40 ns (about 18 minutes), longer samples share the last
+// bucket.
+#define TL_PROFILER_PHASE_SUB_BITS 4
+#define TL_PROFILER_PHASE_EXPONENT_MAXIMUM 40
+#define TL_PROFILER_PHASE_BUCKETS ((TL_PROFILER_PHASE_EXPONENT_MAXIMUM - TL_PROFILER_PHASE_SUB_BITS + 2) << TL_PROFILER_PHASE_SUB_BITS)
+
+typedef struct {
+    u64 samples;
+    u64 maximum;
+    u32 buckets[TL_PROFILER_PHASE_BUCKETS];
+} TLProfilerPhaseHistogram;
+
 #endif
\ No newline at end of file
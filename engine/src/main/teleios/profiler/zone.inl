@@ -0,0 +1,426 @@
+#ifndef __TELEIOS_PROFILER_ZONE__
+#define __TELEIOS_PROFILER_ZONE__
+
+#include "teleios/teleios.h"
+#include "teleios/profiler/types.inl"
+
+// ---------------------------------
+// Timestamps
+//
+// The TSC costs a handful of cycles and is invariant on every x86 CPU we
+// target. It is converted to nanoseconds at collection time, against the
+// monotonic clock sampled when the zones were first enabled. Elsewhere the
+// monotonic clock is read directly.
+// ---------------------------------
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+#   else
+#       include <x86intrin.h>
+#   endif
+#   define TL_PROFILER_ZONE_TSC 1
+#else
+#   define TL_PROFILER_ZONE_TSC 0
+#endif
+
+static inline u64 tl_profiler_zone_ticks(void) {
+#if TL_PROFILER_ZONE_TSC
+    return __rdtsc();
+#else
+    return tl_time_monotonic_nanos();
+#endif
+}
+
+static atomic_bool m_zones_enabled = false;
+static u64 m_zones_base_ticks = 0;
+static u64 m_zones_base_nanos = 0;
+
+// Guards the ring list, the collection cursors and the lost count
+static atomic_flag m_zones_lock = ATOMIC_FLAG_INIT;
+static TLProfilerZoneRing* m_zones_rings = NULL;
+static u64 m_zones_lost = 0;
+static TL_THREADLOCAL TLProfilerZoneRing* m_zones_ring = NULL;
+static TL_THREADLOCAL char m_zones_thread_name[TL_PROFILER_THREAD_NAME_SIZE] = { 0 };
+
+static const TLProfilerZone m_zones_frame = { "frame", __FILE__, "tl_profiler_frame_mark", __LINE__, TL_PROFILER_EVENT_INSTANT };
+
+static void tl_profiler_zones_lock(void) {
+    while (atomic_flag_test_and_set_explicit(&m_zones_lock, memory_order_acquire)) {
+        // Held to register a ring or during a collection
+    }
+}
+
+static void tl_profiler_zones_unlock(void) {
+    atomic_flag_clear_explicit(&m_zones_lock, memory_order_release);
+}
+
+static TLProfilerZoneRing* tl_profiler_zone_ring_create(void) {
+    TLProfilerZoneRing* ring = malloc(sizeof(TLProfilerZoneRing));
+    if (ring == NULL) {
+        tl_logger_write(TL_LOG_LEVEL_FATAL, __FILE__, __LINE__, "Failed to allocate the profiler zone ring");
+        exit(99);
+    }
+
+    ring->thread = tl_thread_current_id();
+    memcpy(ring->name, m_zones_thread_name, TL_PROFILER_THREAD_NAME_SIZE);
+    atomic_init(&ring->head, 0);
+    ring->tail = 0;
+
+    tl_profiler_zones_lock();
+    ring->next = m_zones_rings;
+    m_zones_rings = ring;
+    tl_profiler_zones_unlock();
+
+    m_zones_ring = ring;
+    return ring;
+}
+
+// Ticks elapsed since the base, in nanoseconds
+static f64 tl_profiler_zones_scale(void) {
+#if TL_PROFILER_ZONE_TSC
+    const u64 ticks = tl_profiler_zone_ticks() - m_zones_base_ticks;
+    const u64 nanos = tl_time_monotonic_nanos() - m_zones_base_nanos;
+    return ticks == 0 ? 1.0 : (f64)nanos / (f64)ticks;
+#else
+    return 1.0;
+#endif
+}
+
+void tl_profiler_zones_enable(const b8 enabled) {
+    tl_profiler_zones_lock();
+    if (enabled && m_zones_base_ticks == 0) {
+        m_zones_base_nanos = tl_time_monotonic_nanos();
+        m_zones_base_ticks = tl_profiler_zone_ticks();
+    }
+    tl_profiler_zones_unlock();
+
+    atomic_store_explicit(&m_zones_enabled, enabled, memory_order_release);
+}
+
+b8 tl_profiler_zones_enabled(void) {
+    return atomic_load_explicit(&m_zones_enabled, memory_order_relaxed);
+}
+
+u64 tl_profiler_zone_begin(void) {
+    if (!atomic_load_explicit(&m_zones_enabled, memory_order_relaxed)) return 0;
+    return tl_profiler_zone_ticks();
+}
+
+static inline void tl_profiler_zone_record(const TLProfilerZone* zone, const u64 begin, const u64 end, const u64 value) {
+    TLProfilerZoneRing* ring = m_zones_ring;
+    if (TL_UNLIKELY(ring == NULL)) ring = tl_profiler_zone_ring_create();
+
+    const u64 head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    TLProfilerZoneRecord* record = &ring->records[head & (TL_PROFILER_ZONE_RING_SIZE - 1)];
+
+    // Orders the previous publish before this overwrite, see the collector
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&record->zone, zone, memory_order_relaxed);
+    atomic_store_explicit(&record->begin, begin, memory_order_relaxed);
+    atomic_store_explicit(&record->end, end, memory_order_relaxed);
+    atomic_store_explicit(&record->value, value, memory_order_relaxed);
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+void tl_profiler_zone_end(const TLProfilerZone* zone, const u64 begin) {
+    if (begin == 0) return;
+    tl_profiler_zone_record(zone, begin, tl_profiler_zone_ticks(), 0);
+}
+
+void tl_profiler_frame_mark(const u64 frame) {
+    if (!atomic_load_explicit(&m_zones_enabled, memory_order_relaxed)) return;
+    tl_profiler_zone_record(&m_zones_frame, tl_profiler_zone_ticks(), 0, frame);
+}
+
+void tl_profiler_counter(const TLProfilerZone* counter, const i64 value) {
+    if (counter == NULL || !atomic_load_explicit(&m_zones_enabled, memory_order_relaxed)) return;
+    tl_profiler_zone_record(counter, tl_profiler_zone_ticks(), 0, (u64)value);
+}
+
+void tl_profiler_thread_name(const char* name) {
+    if (name == NULL) return;
+    snprintf(m_zones_thread_name, TL_PROFILER_THREAD_NAME_SIZE, "%s", name);
+
+    // Rings are only read by the exporter, under the lock
+    if (m_zones_ring != NULL) {
+        tl_profiler_zones_lock();
+        memcpy(m_zones_ring->name, m_zones_thread_name, TL_PROFILER_THREAD_NAME_SIZE);
+        tl_profiler_zones_unlock();
+    }
+}
+
+u32 tl_profiler_zones_collect(TLProfilerZoneEvent* events, const u32 capacity) {
+    if (events == NULL || capacity == 0) return 0;
+
+    tl_profiler_zones_lock();
+    const f64 scale = tl_profiler_zones_scale();
+
+    u32 count = 0;
+    for (TLProfilerZoneRing* ring = m_zones_rings; ring != NULL && count < capacity; ring = ring->next) {
+        const u64 head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        u64 from = ring->tail;
+        if (head - from > TL_PROFILER_ZONE_RING_SIZE) {
+            m_zones_lost += head - from - TL_PROFILER_ZONE_RING_SIZE;
+            from = head - TL_PROFILER_ZONE_RING_SIZE;
+        }
+
+        u64 to = head;
+        if (to - from > capacity - count) to = from + (capacity - count);
+
+        const u32 first = count;
+        for (u64 index = from; index < to; ++index) {
+            const TLProfilerZoneRecord* record = &ring->records[index & (TL_PROFILER_ZONE_RING_SIZE - 1)];
+            TLProfilerZoneEvent* event = &events[count++];
+            const u64 end = atomic_load_explicit(&record->end, memory_order_relaxed);
+            event->zone = atomic_load_explicit(&record->zone, memory_order_relaxed);
+            event->type = event->zone->type;
+            event->thread = ring->thread;
+            event->begin = (u64)((f64)(atomic_load_explicit(&record->begin, memory_order_relaxed) - m_zones_base_ticks) * scale);
+            event->end = end == 0 ? event->begin : (u64)((f64)(end - m_zones_base_ticks) * scale);
+            event->value = atomic_load_explicit(&record->value, memory_order_relaxed);
+        }
+
+        // Slots reused by the owner while they were copied hold the wrong record
+        atomic_thread_fence(memory_order_acquire);
+        const u64 written = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        if (written >= TL_PROFILER_ZONE_RING_SIZE && written - TL_PROFILER_ZONE_RING_SIZE >= from) {
+            const u64 overwritten = written - TL_PROFILER_ZONE_RING_SIZE + 1 - from;
+            const u32 dropped = overwritten > to - from ? (u32)(to - from) : (u32)overwritten;
+            memmove(&events[first], &events[first + dropped], sizeof(TLProfilerZoneEvent) * (count - first - dropped));
+            count -= dropped;
+            m_zones_lost += dropped;
+        }
+
+        ring->tail = to;
+    }
+
+    tl_profiler_zones_unlock();
+    return count;
+}
+
+// ---------------------------------
+// Consumers
+//
+// tl_profiler_zones_dump() and the trace both drain the rings through
+// tl_profiler_zones_drain(), so every event reaches the two of them.
+// ---------------------------------
+typedef struct {
+    const TLProfilerZone* zone;
+    u64 calls;
+    u64 total;                  // Zones only
+    u64 maximum;                // Zones only
+    i64 last;                   // Counters only
+    i64 lowest;                 // Counters only
+    i64 highest;                // Counters only
+} TLProfilerZoneSummary;
+
+static atomic_flag m_drain_lock = ATOMIC_FLAG_INIT;
+static TLProfilerZoneSummary m_summaries[TL_PROFILER_ZONE_SUMMARY_SIZE];
+static u32 m_summaries_count = 0;
+static FILE* m_trace = NULL;
+static atomic_bool m_tracing = false;
+
+static void tl_profiler_drain_lock(void) {
+    while (atomic_flag_test_and_set_explicit(&m_drain_lock, memory_order_acquire)) {
+        // Held while the rings are drained
+    }
+}
+
+static void tl_profiler_drain_unlock(void) {
+    atomic_flag_clear_explicit(&m_drain_lock, memory_order_release);
+}
+
+static void tl_profiler_zones_summarize(const TLProfilerZoneEvent* event) {
+    u32 slot = (u32)((uintptr_t)event->zone >> 4) & (TL_PROFILER_ZONE_SUMMARY_SIZE - 1);
+    while (m_summaries[slot].zone != NULL && m_summaries[slot].zone != event->zone) {
+        slot = (slot + 1) & (TL_PROFILER_ZONE_SUMMARY_SIZE - 1);
+    }
+
+    TLProfilerZoneSummary* summary = &m_summaries[slot];
+    if (summary->zone == NULL) {
+        // Keep one slot free so the probe above always ends
+        if (m_summaries_count == TL_PROFILER_ZONE_SUMMARY_SIZE - 1) return;
+        summary->zone = event->zone;
+        m_summaries_count++;
+    }
+
+    summary->calls++;
+    if (event->type == TL_PROFILER_EVENT_COUNTER) {
+        const i64 value = (i64)event->value;
+        if (summary->calls == 1 || value < summary->lowest) summary->lowest = value;
+        if (summary->calls == 1 || value > summary->highest) summary->highest = value;
+        summary->last = value;
+        return;
+    }
+
+    const u64 elapsed = event->end - event->begin;
+    summary->total += elapsed;
+    if (elapsed > summary->maximum) summary->maximum = elapsed;
+}
+
+// File names carry backslashes on Windows
+static void tl_profiler_trace_string(const char* text) {
+    fputc('"', m_trace);
+    for (const char* c = text; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') fputc('\\', m_trace);
+        fputc(*c, m_trace);
+    }
+    fputc('"', m_trace);
+}
+
+static void tl_profiler_trace_event(const TLProfilerZoneEvent* event) {
+    // Counter tracks belong to the process, samples of every thread share one
+    if (event->type == TL_PROFILER_EVENT_COUNTER) {
+        fprintf(m_trace, ",\n{\"name\":");
+        tl_profiler_trace_string(event->zone->name);
+        fprintf(m_trace, ",\"cat\":\"counter\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"value\":%lld}}",
+            (f64)event->begin / 1000.0, (long long)event->value);
+        return;
+    }
+
+    if (event->type == TL_PROFILER_EVENT_INSTANT) {
+        fprintf(m_trace, ",\n{\"name\":");
+        tl_profiler_trace_string(event->zone->name);
+        fprintf(m_trace, ",\"cat\":\"frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%llu,\"ts\":%.3f,\"args\":{\"frame\":%llu}}",
+            (unsigned long long)event->thread, (f64)event->begin / 1000.0, (unsigned long long)event->value);
+        return;
+    }
+
+    fprintf(m_trace, ",\n{\"name\":");
+    tl_profiler_trace_string(event->zone->name);
+    fprintf(m_trace, ",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":%llu,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"function\":",
+        (unsigned long long)event->thread, (f64)event->begin / 1000.0, (f64)(event->end - event->begin) / 1000.0);
+    tl_profiler_trace_string(event->zone->function);
+    fprintf(m_trace, ",\"file\":");
+    tl_profiler_trace_string(event->zone->filename);
+    fprintf(m_trace, ",\"line\":%u}}", event->zone->lineno);
+}
+
+// The drain lock must be held
+static void tl_profiler_zones_drain(void) {
+    TLProfilerZoneEvent events[256];
+    u32 collected = 0;
+    while ((collected = tl_profiler_zones_collect(events, 256)) > 0) {
+        for (u32 i = 0; i < collected; ++i) {
+            if (events[i].type != TL_PROFILER_EVENT_INSTANT) tl_profiler_zones_summarize(&events[i]);
+            if (m_trace != NULL) tl_profiler_trace_event(&events[i]);
+        }
+    }
+}
+
+void tl_profiler_zones_dump(void) {
+    tl_profiler_drain_lock();
+    tl_profiler_zones_drain();
+
+    tl_profiler_zones_lock();
+    const u64 lost = m_zones_lost;
+    m_zones_lost = 0;
+    tl_profiler_zones_unlock();
+
+    TLINFO("Profiler zones: %u zones and counters, %llu lost", m_summaries_count, lost)
+    for (u32 i = 0; i < TL_PROFILER_ZONE_SUMMARY_SIZE; ++i) {
+        const TLProfilerZoneSummary* summary = &m_summaries[i];
+        if (summary->zone == NULL) continue;
+
+        if (summary->zone->type == TL_PROFILER_EVENT_COUNTER) {
+            TLINFO("  %-24s %10llu samples %12lld last %12lld min %12lld max",
+                summary->zone->name,
+                summary->calls,
+                summary->last,
+                summary->lowest,
+                summary->highest)
+            continue;
+        }
+
+        TLINFO("  %-24s %10llu calls %12.3f ms total %10.3f us avg %10.3f us max",
+            summary->zone->name,
+            summary->calls,
+            (f64)summary->total / 1000000.0,
+            (f64)summary->total / (f64)summary->calls / 1000.0,
+            (f64)summary->maximum / 1000.0)
+    }
+
+    memset(m_summaries, 0, sizeof(m_summaries));
+    m_summaries_count = 0;
+    tl_profiler_drain_unlock();
+}
+
+b8 tl_profiler_trace_begin(const char* path) {
+    if (path == NULL) return false;
+
+    tl_profiler_drain_lock();
+    if (m_trace != NULL) {
+        tl_profiler_drain_unlock();
+        TLWARN("Profiler trace already open, %s ignored", path)
+        return false;
+    }
+
+    m_trace = fopen(path, "w");
+    if (m_trace == NULL) {
+        tl_profiler_drain_unlock();
+        TLERROR("Failed to create profiler trace %s", path)
+        return false;
+    }
+
+    // Array format: events are appended with a leading comma after this one
+    fprintf(m_trace, "[{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"teleios\"}}");
+    atomic_store_explicit(&m_tracing, true, memory_order_relaxed);
+    tl_profiler_drain_unlock();
+
+    tl_profiler_zones_enable(true);
+    TLINFO("Profiler trace started: %s", path)
+    return true;
+}
+
+void tl_profiler_trace_flush(void) {
+    if (!atomic_load_explicit(&m_tracing, memory_order_relaxed)) return;
+
+    tl_profiler_drain_lock();
+    if (m_trace != NULL) tl_profiler_zones_drain();
+    tl_profiler_drain_unlock();
+}
+
+void tl_profiler_trace_end(void) {
+    if (!atomic_load_explicit(&m_tracing, memory_order_relaxed)) return;
+
+    tl_profiler_drain_lock();
+    tl_profiler_zones_drain();
+
+    tl_profiler_zones_lock();
+    for (const TLProfilerZoneRing* ring = m_zones_rings; ring != NULL; ring = ring->next) {
+        if (ring->name[0] == '\0') continue;
+        fprintf(m_trace, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%llu,\"args\":{\"name\":", (unsigned long long)ring->thread);
+        tl_profiler_trace_string(ring->name);
+        fprintf(m_trace, "}}");
+    }
+    tl_profiler_zones_unlock();
+
+    fprintf(m_trace, "\n]\n");
+    fclose(m_trace);
+    m_trace = NULL;
+    atomic_store_explicit(&m_tracing, false, memory_order_relaxed);
+    tl_profiler_drain_unlock();
+
+    TLINFO("Profiler trace written")
+}
+
+void tl_profiler_zones_release(void) {
+    atomic_store_explicit(&m_zones_enabled, false, memory_order_relaxed);
+
+    tl_profiler_zones_lock();
+    TLProfilerZoneRing* ring = m_zones_rings;
+    while (ring != NULL) {
+        TLProfilerZoneRing* next = ring->next;
+        free(ring);
+        ring = next;
+    }
+
+    m_zones_rings = NULL;
+    m_zones_lost = 0;
+    tl_profiler_zones_unlock();
+
+    // Other threads are gone by now, only this one may record again
+    m_zones_ring = NULL;
+}
+
+#endif
@@ -30,6 +30,7 @@ void tl_scene_update(const f64 delta) {
 void tl_scene_frame_end() {
     const TLScene* scene = global->scene;
     tl_scene_execute_script(scene, scene->script_frame_end);
+    TL_PROFILER_COUNTER("lua_bytes", (i64)lua_gc((lua_State*)scene->lua_state, LUA_GCCOUNT) * 1024 + lua_gc((lua_State*)scene->lua_state, LUA_GCCOUNTB))
     tl_graphics_update();
 }
 
@@ -5,7 +5,7 @@
 
 TLScene* tl_scene_create(void) {
     TL_PROFILER_PUSH
-    TLScene* scene = tl_memory_alloc(global->allocator, TL_MEMORY_SCENE, sizeof(TLScene));
+    TLScene* scene = tl_memory_alloc_zeroed(global->allocator, TL_MEMORY_SCENE, sizeof(TLScene));
     tl_array_push(m_scenes, scene);
     TL_PROFILER_POP_WITH(scene)
 }
@@ -15,9 +15,10 @@ TLScene* tl_scene_create(void) {
 void tl_scene_load(TLScene* scene) {
     TL_PROFILER_PUSH
 
-    TLAllocator* allocator = tl_memory_allocator_create(TL_KIBI_BYTES(4), TL_ALLOCATOR_LINEAR);
-    tl_scene_apply_graphics_config(allocator, scene);
-    tl_memory_allocator_destroy(allocator);
+    TLAllocator* scratch = tl_memory_scratch();
+    const TLMemoryMarker marker = tl_memory_stack_push_marker(scratch);
+    tl_scene_apply_graphics_config(scratch, scene);
+    tl_memory_stack_pop_to_marker(scratch, marker);
 
     tl_scene_execute_script(scene, scene->script_load);
 
@@ -12,8 +12,9 @@ TLScene* tl_config_get_scene(const TLString* name) {
     // ==========================================
     // 1. Criação da Cena
     // ==========================================
-    TLScene* scene = tl_memory_alloc(global->allocator, TL_MEMORY_SCENE, sizeof(TLScene));
-    TLAllocator* allocator = tl_memory_allocator_create(TL_KIBI_BYTES(4), TL_ALLOCATOR_LINEAR);
+    TLScene* scene = tl_memory_alloc_zeroed(global->allocator, TL_MEMORY_SCENE, sizeof(TLScene));
+    TLAllocator* allocator = tl_memory_scratch();
+    const TLMemoryMarker marker = tl_memory_stack_push_marker(allocator);
 
     // ==========================================
     //
@@ -53,7 +54,7 @@ TLScene* tl_config_get_scene(const TLString* name) {
     }
 
     if (index == U8_MAX) {
-        tl_memory_allocator_destroy(allocator);
+        tl_memory_stack_pop_to_marker(allocator, marker);
         tl_memory_free(global->allocator, scene);
         TLWARN("Scene '%s' not found in application.yml", tl_string_cstr(name));
         TL_PROFILER_POP_WITH(NULL)
@@ -91,7 +92,7 @@ TLScene* tl_config_get_scene(const TLString* name) {
         TLDEBUG("  script.frame_end: %s", tl_string_cstr(scene->script_frame_end));
     } else TLWARN("  - TLScene %s :: script.frame_end is missing", tl_string_cstr(name));
 
-    tl_memory_allocator_destroy(allocator);
+    tl_memory_stack_pop_to_marker(allocator, marker);
     TL_PROFILER_POP_WITH(scene)
 }
 
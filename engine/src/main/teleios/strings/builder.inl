@@ -16,8 +16,9 @@ TLStringBuilder* tl_string_builder_create(TLAllocator* allocator, const u32 capa
 
     if (allocator == NULL) TLFATAL("allocator is NULL")
 
-    TLStringBuilder* builder = (TLStringBuilder*)tl_memory_alloc(allocator, TL_MEMORY_STRING, sizeof(TLStringBuilder));
+    TLStringBuilder* builder = (TLStringBuilder*)tl_memory_alloc_zeroed(allocator, TL_MEMORY_STRING, sizeof(TLStringBuilder));
     builder->buffer = (char*)tl_memory_alloc(allocator, TL_MEMORY_STRING, capacity);
+    builder->buffer[0] = '\0';
 
     builder->capacity = capacity;
     builder->allocator = allocator;
@@ -35,11 +36,7 @@ static void tl_string_builder_ensure_capacity(TLStringBuilder* builder, u32 requ
         new_capacity *= 2;
     }
 
-    char* new_buffer = (char*)tl_memory_alloc(builder->allocator, TL_MEMORY_STRING, new_capacity);
-    tl_memory_copy(new_buffer, builder->buffer, builder->length + 1);
-    tl_memory_free(builder->allocator, builder->buffer);
-
-    builder->buffer = new_buffer;
+    builder->buffer = (char*)tl_memory_realloc(builder->allocator, TL_MEMORY_STRING, builder->buffer, builder->capacity, new_capacity);
     builder->capacity = new_capacity;
 }
 
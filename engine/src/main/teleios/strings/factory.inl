@@ -12,11 +12,12 @@ TLString* tl_string_create(TLAllocator* allocator, const char* cstr) {
 
     const u32 length = (u32) strlen(cstr);
 
-    TLString* str = (TLString*)tl_memory_alloc(allocator, TL_MEMORY_STRING, sizeof(TLString));
+    TLString* str = (TLString*)tl_memory_alloc_zeroed(allocator, TL_MEMORY_STRING, sizeof(TLString));
     str->data = (char*)tl_memory_alloc(allocator, TL_MEMORY_STRING, length + 1);
     str->length = length;
     str->allocator = allocator;
     tl_memory_copy(str->data, cstr, length);
+    str->data[length] = '\0';
 
     TL_PROFILER_POP_WITH(str)
 }
@@ -26,8 +27,9 @@ TLString* tl_string_create_empty(TLAllocator* allocator) {
 
     if (allocator == NULL) TLFATAL("allocator is NULL")
 
-    TLString* str = (TLString*)tl_memory_alloc(allocator, TL_MEMORY_STRING, sizeof(TLString));
+    TLString* str = (TLString*)tl_memory_alloc_zeroed(allocator, TL_MEMORY_STRING, sizeof(TLString));
     str->data = (char*)tl_memory_alloc(allocator, TL_MEMORY_STRING, 1);
+    str->data[0] = '\0';
     str->allocator = allocator;
 
     TL_PROFILER_POP_WITH(str)
@@ -38,8 +40,9 @@ TLString* tl_string_reserve(TLAllocator* allocator, const u32 capacity) {
 
     if (allocator == NULL) TLFATAL("allocator is NULL")
 
-    TLString* str = (TLString*)tl_memory_alloc(allocator, TL_MEMORY_STRING, sizeof(TLString));
+    TLString* str = (TLString*)tl_memory_alloc_zeroed(allocator, TL_MEMORY_STRING, sizeof(TLString));
     str->data = (char*)tl_memory_alloc(allocator, TL_MEMORY_STRING, capacity + 1);
+    str->data[0] = '\0';
     str->allocator = allocator;
 
     TL_PROFILER_POP_WITH(str)
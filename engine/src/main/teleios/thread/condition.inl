@@ -10,7 +10,7 @@ TLCondition* tl_condition_create(TLAllocator* allocator) {
         TL_PROFILER_POP_WITH(NULL)
     }
 
-    TLCondition* condition = (TLCondition*)tl_memory_alloc(allocator, TL_MEMORY_THREAD, sizeof(TLCondition));
+    TLCondition* condition = (TLCondition*)tl_memory_alloc_zeroed(allocator, TL_MEMORY_THREAD, sizeof(TLCondition));
     condition->allocator = allocator;
 
 #if defined(TL_PLATFORM_UNIX)
@@ -62,14 +62,18 @@ b8 tl_condition_wait(TLCondition* condition, TLMutex* mutex) {
         TL_PROFILER_POP_WITH(false)
     }
 
+    // Time spent waiting is not time holding the mutex
+    tl_mutex_released(mutex);
 #if defined(TL_PLATFORM_UNIX)
     i32 result = pthread_cond_wait(&condition->cond, &mutex->mutex);
+    tl_mutex_held(mutex);
     if (result != 0) {
         TLERROR("tl_condition_wait: pthread_cond_wait failed with error %d", result);
         TL_PROFILER_POP_WITH(false)
     }
 #elif defined(TL_PLATFORM_WINDOWS)
     const BOOL result = SleepConditionVariableCS(&condition->cv, &mutex->cs, INFINITE);
+    tl_mutex_held(mutex);
     if (!result) {
         TLERROR("tl_condition_wait: SleepConditionVariableCS failed with error %lu", GetLastError());
         TL_PROFILER_POP_WITH(false)
@@ -103,7 +107,9 @@ b8 tl_condition_wait_timeout(TLCondition* condition, TLMutex* mutex, const u32 t
     ts.tv_sec += nsec / 1000000000ULL;
     ts.tv_nsec = nsec % 1000000000ULL;
 
+    tl_mutex_released(mutex);
     i32 result = pthread_cond_timedwait(&condition->cond, &mutex->mutex, &ts);
+    tl_mutex_held(mutex);
     if (result == ETIMEDOUT) {
         TL_PROFILER_POP_WITH(false)  // Timeout, not an error
     }
@@ -112,7 +118,9 @@ b8 tl_condition_wait_timeout(TLCondition* condition, TLMutex* mutex, const u32 t
         TL_PROFILER_POP_WITH(false)
     }
 #elif defined(TL_PLATFORM_WINDOWS)
+    tl_mutex_released(mutex);
     const b8 result = (b8)SleepConditionVariableCS(&condition->cv, &mutex->cs, timeout_ms);
+    tl_mutex_held(mutex);
     if (!result) {
         const u32 error = (u32)GetLastError();
         if (error == ERROR_TIMEOUT) {
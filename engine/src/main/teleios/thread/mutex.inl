@@ -3,15 +3,111 @@
 #include "teleios/teleios.h"
 #include "teleios/thread/types.inl"
 
-TLMutex* tl_mutex_create(TLAllocator* allocator) {
-    TL_PROFILER_PUSH_WITH("0x%p", allocator)
+#if TELEIOS_THREAD_CONTENTION
+static atomic_flag m_mutex_sites_lock = ATOMIC_FLAG_INIT;
+static TLMutexSite m_mutex_sites[TL_MUTEX_SITE_MAXIMUM];
+static u32 m_mutex_sites_count = 0;
+
+static void tl_mutex_sites_lock(void) {
+    while (atomic_flag_test_and_set_explicit(&m_mutex_sites_lock, memory_order_acquire)) {
+        // Held only to look up or add a name
+    }
+}
+
+static void tl_mutex_sites_unlock(void) {
+    atomic_flag_clear_explicit(&m_mutex_sites_lock, memory_order_release);
+}
+
+// The lock must be held
+static TLMutexSite* tl_mutex_site_find(const char* name) {
+    for (u32 i = 0; i < m_mutex_sites_count; ++i) {
+        if (strncmp(m_mutex_sites[i].name, name, TL_MUTEX_NAME_SIZE - 1) == 0) return &m_mutex_sites[i];
+    }
+
+    return NULL;
+}
+
+static TLMutexSite* tl_mutex_site_acquire(const char* name) {
+    if (name == NULL) name = "unnamed";
+
+    tl_mutex_sites_lock();
+    TLMutexSite* site = tl_mutex_site_find(name);
+    if (site == NULL && m_mutex_sites_count < TL_MUTEX_SITE_MAXIMUM) {
+        site = &m_mutex_sites[m_mutex_sites_count++];
+        snprintf(site->name, TL_MUTEX_NAME_SIZE, "%s", name);
+        snprintf(site->labels[0], sizeof(site->labels[0]), "mutex.%.31s.contended", name);
+        snprintf(site->labels[1], sizeof(site->labels[1]), "mutex.%.31s.wait_us", name);
+        site->counters[0] = (TLProfilerZone){ site->labels[0], __FILE__, __func__, __LINE__, TL_PROFILER_EVENT_COUNTER };
+        site->counters[1] = (TLProfilerZone){ site->labels[1], __FILE__, __func__, __LINE__, TL_PROFILER_EVENT_COUNTER };
+    }
+    tl_mutex_sites_unlock();
+
+    if (site == NULL) TLWARN("TL_MUTEX_SITE_MAXIMUM of %d exceeded, mutex %s is not measured", TL_MUTEX_SITE_MAXIMUM, name)
+    return site;
+}
+
+static void tl_mutex_site_maximum(_Atomic u64* maximum, const u64 value) {
+    u64 current = atomic_load_explicit(maximum, memory_order_relaxed);
+    while (value > current && !atomic_compare_exchange_weak_explicit(maximum, &current, value, memory_order_relaxed, memory_order_relaxed)) {
+        // current reloaded by the failed exchange
+    }
+}
+
+// Called right after the owner got the mutex, `waited` is 0 when it was free
+static void tl_mutex_acquired(TLMutex* mutex, const b8 contended, const u64 waited) {
+    TLMutexSite* site = mutex->site;
+    if (site == NULL) return;
+
+    atomic_fetch_add_explicit(&site->acquisitions, 1, memory_order_relaxed);
+    if (contended) {
+        atomic_fetch_add_explicit(&site->contended, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&site->wait_total, waited, memory_order_relaxed);
+        tl_mutex_site_maximum(&site->wait_maximum, waited);
+    }
+}
+
+// Opens the hold window, also when a condition wait hands the mutex back
+static inline void tl_mutex_held(TLMutex* mutex) {
+    if (mutex->site != NULL) mutex->locked_at = tl_time_monotonic_nanos();
+}
+
+// Closes the hold window, before an unlock or a condition wait
+static inline void tl_mutex_released(TLMutex* mutex) {
+    TLMutexSite* site = mutex->site;
+    if (site == NULL) return;
+
+    const u64 held = tl_time_monotonic_nanos() - mutex->locked_at;
+    atomic_fetch_add_explicit(&site->hold_total, held, memory_order_relaxed);
+    tl_mutex_site_maximum(&site->hold_maximum, held);
+}
+
+static void tl_mutex_site_read(TLMutexSite* site, TLMutexStats* stats) {
+    stats->acquisitions = atomic_load_explicit(&site->acquisitions, memory_order_relaxed);
+    stats->contended = atomic_load_explicit(&site->contended, memory_order_relaxed);
+    stats->wait_total = atomic_load_explicit(&site->wait_total, memory_order_relaxed);
+    stats->wait_maximum = atomic_load_explicit(&site->wait_maximum, memory_order_relaxed);
+    stats->hold_total = atomic_load_explicit(&site->hold_total, memory_order_relaxed);
+    stats->hold_maximum = atomic_load_explicit(&site->hold_maximum, memory_order_relaxed);
+}
+#else
+#   define tl_mutex_held(mutex)
+#   define tl_mutex_released(mutex)
+#endif
+
+TLMutex* tl_mutex_create(TLAllocator* allocator, const char* name) {
+    TL_PROFILER_PUSH_WITH("0x%p, %s", allocator, name)
     if (allocator == NULL) {
         TLERROR("Attempted to use a NULL TLAllocator")
         TL_PROFILER_POP_WITH(NULL)
     }
 
-    TLMutex* mutex = (TLMutex*)tl_memory_alloc(allocator, TL_MEMORY_THREAD, sizeof(TLMutex));
+    TLMutex* mutex = (TLMutex*)tl_memory_alloc_zeroed(allocator, TL_MEMORY_THREAD, sizeof(TLMutex));
     mutex->allocator = allocator;
+#if TELEIOS_THREAD_CONTENTION
+    mutex->site = tl_mutex_site_acquire(name);
+#else
+    (void)name; // Only traced
+#endif
 
 #if defined(TL_PLATFORM_UNIX)
     i32 result = pthread_mutex_init(&mutex->mutex, NULL);
@@ -56,6 +152,37 @@ b8 tl_mutex_lock(TLMutex* mutex) {
         TL_PROFILER_POP_WITH(false)
     }
 
+#if TELEIOS_THREAD_CONTENTION
+    // Only a failed trylock pays for timing the wait
+    if (mutex->site != NULL) {
+#   if defined(TL_PLATFORM_UNIX)
+        const b8 available = pthread_mutex_trylock(&mutex->mutex) == 0;
+#   elif defined(TL_PLATFORM_WINDOWS)
+        const b8 available = TryEnterCriticalSection(&mutex->cs) != 0;
+#   endif
+        if (available) {
+            tl_mutex_acquired(mutex, false, 0);
+            tl_mutex_held(mutex);
+            TL_PROFILER_POP_WITH(true)
+        }
+
+        const u64 waiting = tl_time_monotonic_nanos();
+#   if defined(TL_PLATFORM_UNIX)
+        i32 result = pthread_mutex_lock(&mutex->mutex);
+        if (result != 0) {
+            TLERROR("tl_mutex_lock: pthread_mutex_lock failed with error %d", result);
+            TL_PROFILER_POP_WITH(false)
+        }
+#   elif defined(TL_PLATFORM_WINDOWS)
+        EnterCriticalSection(&mutex->cs);
+#   endif
+        const u64 now = tl_time_monotonic_nanos();
+        tl_mutex_acquired(mutex, true, now - waiting);
+        mutex->locked_at = now;
+        TL_PROFILER_POP_WITH(true)
+    }
+#endif
+
 #if defined(TL_PLATFORM_UNIX)
     i32 result = pthread_mutex_lock(&mutex->mutex);
     if (result != 0) {
@@ -88,6 +215,12 @@ b8 tl_mutex_trylock(TLMutex* mutex) {
     }
 #elif defined(TL_PLATFORM_WINDOWS)
     locked = TryEnterCriticalSection(&mutex->cs) != 0;
+#endif
+#if TELEIOS_THREAD_CONTENTION
+    if (locked) {
+        tl_mutex_acquired(mutex, false, 0);
+        tl_mutex_held(mutex);
+    }
 #endif
     TL_PROFILER_POP_WITH(locked)
 }
@@ -99,6 +232,8 @@ b8 tl_mutex_unlock(TLMutex* mutex) {
         TL_PROFILER_POP_WITH(false)
     }
 
+    tl_mutex_released(mutex);
+
 #if defined(TL_PLATFORM_UNIX)
     i32 result = pthread_mutex_unlock(&mutex->mutex);
     if (result != 0) {
@@ -111,4 +246,80 @@ b8 tl_mutex_unlock(TLMutex* mutex) {
     TL_PROFILER_POP_WITH(true)
 }
 
-#endif
\ No newline at end of file
+b8 tl_mutex_stats(const char* name, TLMutexStats* stats) {
+    TL_PROFILER_PUSH_WITH("%s, 0x%p", name, stats)
+    if (stats == NULL) TL_PROFILER_POP_WITH(false)
+    memset(stats, 0, sizeof(TLMutexStats));
+
+#if TELEIOS_THREAD_CONTENTION
+    if (name == NULL) TL_PROFILER_POP_WITH(false)
+
+    tl_mutex_sites_lock();
+    TLMutexSite* site = tl_mutex_site_find(name);
+    tl_mutex_sites_unlock();
+
+    if (site == NULL) TL_PROFILER_POP_WITH(false)
+    tl_mutex_site_read(site, stats);
+    TL_PROFILER_POP_WITH(true)
+#else
+    (void)name; // Only traced
+    TL_PROFILER_POP_WITH(false)
+#endif
+}
+
+void tl_mutex_stats_dump(void) {
+    TL_PROFILER_PUSH
+#if TELEIOS_THREAD_CONTENTION
+    tl_mutex_sites_lock();
+    const u32 count = m_mutex_sites_count;
+    tl_mutex_sites_unlock();
+
+    // Sites are never removed, the first `count` stay valid without the lock
+    u32 order[TL_MUTEX_SITE_MAXIMUM];
+    TLMutexStats stats[TL_MUTEX_SITE_MAXIMUM];
+    for (u32 i = 0; i < count; ++i) {
+        tl_mutex_site_read(&m_mutex_sites[i], &stats[i]);
+
+        u32 slot = i;
+        while (slot > 0 && stats[order[slot - 1]].contended < stats[i].contended) {
+            order[slot] = order[slot - 1];
+            slot--;
+        }
+        order[slot] = i;
+    }
+
+    TLINFO("Mutex contention: %u names", count)
+    for (u32 i = 0; i < count; ++i) {
+        const TLMutexStats* entry = &stats[order[i]];
+        if (entry->acquisitions == 0) continue;
+
+        TLINFO("  %-24s %10llu locks %10llu contended %10.3f ms waited %10.3f us max wait %10.3f ms held %10.3f us max hold",
+            m_mutex_sites[order[i]].name,
+            entry->acquisitions,
+            entry->contended,
+            (f64)entry->wait_total / 1000000.0,
+            (f64)entry->wait_maximum / 1000.0,
+            (f64)entry->hold_total / 1000000.0,
+            (f64)entry->hold_maximum / 1000.0)
+    }
+#endif
+    TL_PROFILER_POP
+}
+
+void tl_mutex_stats_sample(void) {
+#if TELEIOS_THREAD_CONTENTION
+    if (!tl_profiler_zones_enabled()) return;
+
+    tl_mutex_sites_lock();
+    const u32 count = m_mutex_sites_count;
+    tl_mutex_sites_unlock();
+
+    for (u32 i = 0; i < count; ++i) {
+        TLMutexSite* site = &m_mutex_sites[i];
+        tl_profiler_counter(&site->counters[0], (i64)atomic_load_explicit(&site->contended, memory_order_relaxed));
+        tl_profiler_counter(&site->counters[1], (i64)(atomic_load_explicit(&site->wait_total, memory_order_relaxed) / 1000));
+    }
+#endif
+}
+
+#endif
@@ -12,7 +12,7 @@ TLThread* tl_thread_create(TLAllocator* allocator, const TLThreadFunction func,
     }
 
     TLDEBUG("Creating thread for function %p", func)
-    TLThread* thread = (TLThread*)tl_memory_alloc(allocator, TL_MEMORY_THREAD, sizeof(TLThread));
+    TLThread* thread = (TLThread*)tl_memory_alloc_zeroed(allocator, TL_MEMORY_THREAD, sizeof(TLThread));
     thread->allocator = allocator;
     thread->func = func;
     thread->arg = arg;
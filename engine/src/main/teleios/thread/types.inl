@@ -1,6 +1,32 @@
 #ifndef __TELEIOS_THREAD_TYPES__
 #define __TELEIOS_THREAD_TYPES__
 
+#if TELEIOS_THREAD_CONTENTION
+#include <stdatomic.h>
+
+// ---------------------------------
+// Lock statistics, one site per mutex name
+//
+// Sites live until the process exits so mutexes never dangle and the
+// profiler counters keep valid descriptors. Every field is updated with
+// relaxed atomics by whoever holds one of the mutexes of the name.
+// ---------------------------------
+#define TL_MUTEX_SITE_MAXIMUM 64
+#define TL_MUTEX_NAME_SIZE 32
+
+typedef struct {
+    char name[TL_MUTEX_NAME_SIZE];
+    _Atomic u64 acquisitions;
+    _Atomic u64 contended;
+    _Atomic u64 wait_total;
+    _Atomic u64 wait_maximum;
+    _Atomic u64 hold_total;
+    _Atomic u64 hold_maximum;
+    char labels[2][TL_MUTEX_NAME_SIZE + 16];
+    TLProfilerZone counters[2];             // Contended acquisitions, wait time
+} TLMutexSite;
+#endif
+
 #   if defined(TL_PLATFORM_WINDOWS)
 // ---------------------------------
 // Internal structures
@@ -21,6 +47,10 @@ struct TLThread {
 struct TLMutex {
     TLAllocator* allocator;
     CRITICAL_SECTION cs;
+#if TELEIOS_THREAD_CONTENTION
+    TLMutexSite* site;
+    u64 locked_at;                          // Written by the owner only
+#endif
 };
 
 struct TLCondition {
@@ -36,6 +66,8 @@ static DWORD WINAPI thread_wrapper(const LPVOID param) {
     TL_PROFILER_PUSH_WITH("0x%p", param)
     TLThread* thread = (TLThread*)param;
     thread->result = thread->func(thread->arg);
+    tl_memory_scratch_release();
+    tl_memory_cache_release();
     TL_PROFILER_POP_WITH(0)
 }
 #   elif defined(TL_PLATFORM_UNIX)
@@ -60,6 +92,10 @@ struct TLThread {
 struct TLMutex {
     TLAllocator* allocator;
     pthread_mutex_t mutex;
+#if TELEIOS_THREAD_CONTENTION
+    TLMutexSite* site;
+    u64 locked_at;                          // Written by the owner only
+#endif
 };
 
 struct TLCondition {
@@ -74,6 +110,8 @@ struct TLCondition {
 static void* thread_wrapper(void* param) {
     TLThread* thread = (TLThread*)param;
     thread->result = thread->func(thread->arg);
+    tl_memory_scratch_release();
+    tl_memory_cache_release();
     return thread->result;
 }
 #   endif
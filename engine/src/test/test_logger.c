@@ -1,5 +1,77 @@
 #include "test_framework.h"
 #include "teleios/teleios.h"
+#ifdef _WIN32
+#   include <io.h>
+#   define dup _dup
+#   define dup2 _dup2
+#   define close _close
+#   define fileno _fileno
+#else
+#   include <unistd.h>
+#endif
+
+#define LOGGER_TEST_PRODUCERS 4
+#define LOGGER_TEST_LINES 400
+
+static void* logger_test_producer(void* arg) {
+    const u32 id = *(const u32*)arg;
+    for (u32 i = 0; i < LOGGER_TEST_LINES; i++) {
+        TLINFO("Async producer %u line %u", id, i)
+    }
+    return NULL;
+}
+
+// stdout is pointed at a file so the asynchronous tests can read back what the writer delivered
+static int m_logger_test_stdout = -1;
+
+static void logger_test_capture_begin(const char* path) {
+    fflush(stdout);
+    m_logger_test_stdout = dup(fileno(stdout));
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) return;
+    dup2(fileno(file), fileno(stdout));
+    fclose(file);
+}
+
+static void logger_test_capture_end(void) {
+    if (m_logger_test_stdout < 0) return;
+
+    fflush(stdout);
+    dup2(m_logger_test_stdout, fileno(stdout));
+    close(m_logger_test_stdout);
+    m_logger_test_stdout = -1;
+}
+
+static char* logger_test_read(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* text = malloc(size < 0 ? 1 : (size_t)size + 1);
+    const size_t read = size < 0 ? 0 : fread(text, 1, (size_t)size, file);
+    text[read] = '\0';
+    fclose(file);
+    return text;
+}
+
+static u32 logger_test_count(const char* text, const char* needle) {
+    u32 count = 0;
+    for (const char* at = strstr(text, needle); at != NULL; at = strstr(at + 1, needle)) count++;
+    return count;
+}
+
+static u64 logger_test_file_size(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) return 0;
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fclose(file);
+    return size < 0 ? 0 : (u64)size;
+}
 
 void test_logger(void) {
     TEST_SUITE_BEGIN("Logger");
@@ -272,5 +344,294 @@ void test_logger(void) {
     }
     TEST_END();
 
+    TEST_BEGIN("logger_async_begin_twice");
+    {
+        // The platform may already run it when teleios.logging.async is set
+        const b8 started = tl_logger_async_begin();
+        ASSERT_FALSE(tl_logger_async_begin());
+
+        // The flush alone has to deliver the line, the writer is still running
+        logger_test_capture_begin("test_logger_async_twice.log");
+        TLINFO("Queued while asynchronous")
+        tl_logger_flush();
+        logger_test_capture_end();
+
+        char* text = logger_test_read("test_logger_async_twice.log");
+        ASSERT_NOT_NULL(text);
+        if (text != NULL) ASSERT_EQ(1, logger_test_count(text, "Queued while asynchronous"));
+        free(text);
+        remove("test_logger_async_twice.log");
+
+        if (started) {
+            tl_logger_async_end();
+            tl_logger_async_end();
+            TLINFO("Synchronous again")
+        }
+    }
+    TEST_END();
+
+    TEST_BEGIN("logger_async_concurrent_producers");
+    {
+        TLLogLevel original = tl_logger_get_level();
+        tl_logger_set_level(TL_LOG_LEVEL_INFO);
+        const b8 started = tl_logger_async_begin();
+        logger_test_capture_begin("test_logger_async_producers.log");
+
+        // 4 x 400 lines overrun the ring, producers must wait for the writer
+        u32 ids[LOGGER_TEST_PRODUCERS] = {0, 1, 2, 3};
+        TLThread* producers[LOGGER_TEST_PRODUCERS];
+        for (u32 i = 0; i < LOGGER_TEST_PRODUCERS; i++) {
+            producers[i] = tl_thread_create(global->allocator, logger_test_producer, &ids[i]);
+            ASSERT_NOT_NULL(producers[i]);
+        }
+
+        for (u32 i = 0; i < LOGGER_TEST_PRODUCERS; i++) {
+            ASSERT_TRUE(tl_thread_join(producers[i], NULL));
+        }
+
+        tl_logger_flush();
+        logger_test_capture_end();
+
+        // Every line is out after the flush, each producer's lines in the order they were logged
+        char* text = logger_test_read("test_logger_async_producers.log");
+        ASSERT_NOT_NULL(text);
+        if (text != NULL) {
+            ASSERT_EQ(LOGGER_TEST_PRODUCERS * LOGGER_TEST_LINES, logger_test_count(text, "Async producer "));
+
+            u32 next[LOGGER_TEST_PRODUCERS] = {0};
+            b8 ordered = true;
+            for (const char* at = strstr(text, "Async producer "); at != NULL; at = strstr(at + 1, "Async producer ")) {
+                u32 id = 0, line = 0;
+                if (sscanf(at, "Async producer %u line %u", &id, &line) != 2 || id >= LOGGER_TEST_PRODUCERS || line != next[id]) {
+                    ordered = false;
+                    break;
+                }
+                next[id]++;
+            }
+            ASSERT_TRUE(ordered);
+        }
+        free(text);
+        remove("test_logger_async_producers.log");
+
+        if (started) tl_logger_async_end();
+        tl_logger_set_level(original);
+    }
+    TEST_END();
+
+    TEST_BEGIN("logger_file_sink_strips_colors");
+    {
+        // The platform may have opened teleios.logging.file, the test takes the sink over
+        tl_logger_file_end();
+
+        const char* path = "test_logger_file.log";
+        ASSERT_TRUE(tl_logger_file_begin(path, TL_KIBI_BYTES(64), 1));
+        ASSERT_FALSE(tl_logger_file_begin(path, TL_KIBI_BYTES(64), 1));
+
+        TLLogLevel original = tl_logger_get_level();
+        const u8 sinks = tl_logger_get_sinks(TL_LOG_LEVEL_INFO);
+        tl_logger_set_level(TL_LOG_LEVEL_INFO);
+        tl_logger_set_sinks(TL_LOG_LEVEL_INFO, TL_LOG_SINK_FILE);
+        TLINFO("File sink line %d", 7)
+        tl_logger_set_sinks(TL_LOG_LEVEL_INFO, 0);
+        ASSERT_EQ(0, tl_logger_get_sinks(TL_LOG_LEVEL_INFO));
+        TLINFO("Dropped by every sink")
+        tl_logger_set_sinks(TL_LOG_LEVEL_INFO, sinks);
+        tl_logger_set_level(original);
+        tl_logger_file_end();
+
+        char text[4096] = {0};
+        FILE* file = fopen(path, "rb");
+        ASSERT_NOT_NULL(file);
+        const size_t length = fread(text, 1, sizeof(text) - 1, file);
+        fclose(file);
+        remove(path);
+
+        // Cut to the written bytes, no preallocated zeros behind the line
+        ASSERT_TRUE(length > 0);
+        ASSERT_EQ('\n', text[length - 1]);
+        ASSERT_EQ(length, strlen(text));
+        ASSERT_NULL(strchr(text, '\033'));
+        ASSERT_NOT_NULL(strstr(text, " INFO    File sink line 7\n"));
+        ASSERT_NULL(strstr(text, "Dropped by every sink"));
+    }
+    TEST_END();
+
+    TEST_BEGIN("logger_file_sink_rotation");
+    {
+        const char* path = "test_logger_rotation.log";
+        ASSERT_TRUE(tl_logger_file_begin(path, TL_KIBI_BYTES(64), 2));
+
+        TLLogLevel original = tl_logger_get_level();
+        const u8 sinks = tl_logger_get_sinks(TL_LOG_LEVEL_INFO);
+        tl_logger_set_level(TL_LOG_LEVEL_INFO);
+        tl_logger_set_sinks(TL_LOG_LEVEL_INFO, TL_LOG_SINK_FILE);
+
+        // About 100 bytes per line, enough for three rotations
+        for (u32 i = 0; i < 2500; i++) {
+            TLINFO("Rotation line %u", i)
+        }
+
+        tl_logger_set_sinks(TL_LOG_LEVEL_INFO, sinks);
+        tl_logger_set_level(original);
+        tl_logger_file_end();
+
+        const u64 current = logger_test_file_size(path);
+        const u64 first = logger_test_file_size("test_logger_rotation.log.1");
+        const u64 second = logger_test_file_size("test_logger_rotation.log.2");
+        ASSERT_TRUE(current > 0);
+        ASSERT_TRUE(first > TL_KIBI_BYTES(60) && first <= TL_KIBI_BYTES(64));
+        ASSERT_TRUE(second > TL_KIBI_BYTES(60) && second <= TL_KIBI_BYTES(64));
+        ASSERT_EQ(0, logger_test_file_size("test_logger_rotation.log.3"));
+
+        remove(path);
+        remove("test_logger_rotation.log.1");
+        remove("test_logger_rotation.log.2");
+    }
+    TEST_END();
+
+    TEST_BEGIN("logger_limited_suppresses_after_burst");
+    {
+        const char* path = "test_logger_limited.log";
+        ASSERT_TRUE(tl_logger_file_begin(path, TL_KIBI_BYTES(64), 0));
+
+        TLLogLevel original = tl_logger_get_level();
+        const u8 sinks = tl_logger_get_sinks(TL_LOG_LEVEL_INFO);
+        tl_logger_set_level(TL_LOG_LEVEL_INFO);
+        tl_logger_set_sinks(TL_LOG_LEVEL_INFO, TL_LOG_SINK_FILE);
+        for (u32 i = 0; i < 100; i++) {
+            TL_LOG_LIMITED(TL_LOG_LEVEL_INFO, 0, 3, "Limited line %u", i)
+        }
+        tl_logger_limit_flush();
+        tl_logger_limit_flush();
+        tl_logger_set_sinks(TL_LOG_LEVEL_INFO, sinks);
+        tl_logger_set_level(original);
+        tl_logger_file_end();
+
+        char text[4096] = {0};
+        FILE* file = fopen(path, "rb");
+        ASSERT_NOT_NULL(file);
+        fread(text, 1, sizeof(text) - 1, file);
+        fclose(file);
+        remove(path);
+
+        ASSERT_NOT_NULL(strstr(text, "Limited line 2\n"));
+        ASSERT_NULL(strstr(text, "Limited line 3\n"));
+        ASSERT_NOT_NULL(strstr(text, "Suppressed 97 similar messages\n"));
+
+        // Reported once, the second flush had nothing left
+        const char* summary = strstr(text, "Suppressed");
+        ASSERT_NULL(strstr(summary + 1, "Suppressed"));
+    }
+    TEST_END();
+
+    TEST_BEGIN("logger_limit_refills_over_time");
+    {
+        static TLLogLimit limit = { .level = TL_LOG_LEVEL_VERBOSE, .lineno = __LINE__, .filename = __FILE__, .rate = 10, .burst = 2 };
+
+        ASSERT_TRUE(tl_logger_limit_acquire(&limit));
+        ASSERT_TRUE(tl_logger_limit_acquire(&limit));
+        ASSERT_FALSE(tl_logger_limit_acquire(&limit));
+        ASSERT_FALSE(tl_logger_limit_acquire(&limit));
+        ASSERT_EQ(2, atomic_load(&limit.suppressed));
+
+        // 10 a second: 250 ms is worth two tokens, capped by the burst
+        tl_thread_sleep(250);
+        ASSERT_TRUE(tl_logger_limit_acquire(&limit));
+        ASSERT_EQ(0, atomic_load(&limit.suppressed));
+        ASSERT_TRUE(tl_logger_limit_acquire(&limit));
+        ASSERT_FALSE(tl_logger_limit_acquire(&limit));
+    }
+    TEST_END();
+
+#ifdef TELEIOS_BUILD_DEBUG
+    TEST_BEGIN("logger_binary_roundtrip");
+    {
+        TLLogLevel original = tl_logger_get_level();
+        tl_logger_set_level(TL_LOG_LEVEL_VERBOSE);
+
+        const char* path = "test_logger_binary.tlb";
+        ASSERT_TRUE(tl_logger_binary_begin(path));
+        ASSERT_FALSE(tl_logger_binary_begin(path));
+
+        for (u32 i = 0; i < 3; i++) {
+            TLDEBUG("Binary %u %s %.2f %llu 100%%", i, "hello", 1.5, (unsigned long long)U64_MAX)
+        }
+        TLTRACE("Binary without arguments")
+        TLINFO("Text while binary")
+        tl_logger_binary_end();
+        tl_logger_set_level(original);
+
+        FILE* input = fopen(path, "rb");
+        ASSERT_NOT_NULL(input);
+        FILE* output = tmpfile();
+        ASSERT_NOT_NULL(output);
+        ASSERT_TRUE(tl_logger_binary_decode(input, output));
+        fclose(input);
+        remove(path);
+
+        char text[4096] = {0};
+        rewind(output);
+        const size_t length = fread(text, 1, sizeof(text) - 1, output);
+        fclose(output);
+
+        ASSERT_TRUE(length > 0);
+        ASSERT_NOT_NULL(strstr(text, "Binary 0 hello 1.50 18446744073709551615 100%\n"));
+        ASSERT_NOT_NULL(strstr(text, "Binary 2 hello 1.50 18446744073709551615 100%\n"));
+        ASSERT_NOT_NULL(strstr(text, "Binary without arguments\n"));
+        ASSERT_NOT_NULL(strstr(text, "test_logger.c:"));
+        ASSERT_NOT_NULL(strstr(text, " DEBUG   Binary 1 "));
+        ASSERT_NULL(strstr(text, "Text while binary"));
+        ASSERT_EQ(0, strncmp(text, "\033[1;34m", 7));
+    }
+    TEST_END();
+
+    TEST_BEGIN("logger_binary_decode_rejects_text");
+    {
+        FILE* input = tmpfile();
+        ASSERT_NOT_NULL(input);
+        fputs("2025-01-01 00:00:00 not a binary log\n", input);
+        rewind(input);
+
+        FILE* output = tmpfile();
+        ASSERT_FALSE(tl_logger_binary_decode(input, output));
+        fclose(output);
+        fclose(input);
+    }
+    TEST_END();
+
+    TEST_BEGIN("logger_binary_decode_rejects_corrupted_site");
+    {
+        FILE* input = tmpfile();
+        ASSERT_NOT_NULL(input);
+
+        // A well formed site record whose id would wrap the site table when doubled
+        const u32 version = 1;
+        const u8 kind = 'S';
+        const u32 id = 0x80000001u;
+        const u8 level = TL_LOG_LEVEL_DEBUG;
+        const u32 lineno = 7;
+        const u16 text = 1;
+        const u16 size = sizeof(id) + sizeof(level) + sizeof(lineno) + 2 * (sizeof(text) + 1);
+        fwrite("TLBL", 1, 4, input);
+        fwrite(&version, sizeof(version), 1, input);
+        fwrite(&kind, sizeof(kind), 1, input);
+        fwrite(&size, sizeof(size), 1, input);
+        fwrite(&id, sizeof(id), 1, input);
+        fwrite(&level, sizeof(level), 1, input);
+        fwrite(&lineno, sizeof(lineno), 1, input);
+        fwrite(&text, sizeof(text), 1, input);
+        fwrite("a", 1, 1, input);
+        fwrite(&text, sizeof(text), 1, input);
+        fwrite("b", 1, 1, input);
+        rewind(input);
+
+        FILE* output = tmpfile();
+        ASSERT_FALSE(tl_logger_binary_decode(input, output));
+        fclose(output);
+        fclose(input);
+    }
+    TEST_END();
+#endif
+
     TEST_SUITE_END();
 }
@@ -10,6 +10,7 @@ extern void test_container(void);
 extern void test_number(void);
 extern void test_event(void);
 extern void test_logger(void);
+extern void test_profiler(void);
 
 // Legacy test - can be removed if desired
 void test_filesystem(void) {
@@ -84,6 +85,7 @@ int main(void) {
     test_number();
     test_container();
     test_event();
+    test_profiler();
     test_filesystem();
 
     // Print summary
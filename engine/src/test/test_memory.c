@@ -1,6 +1,85 @@
 #include "test_framework.h"
 #include "teleios/teleios.h"
 
+#define SHARED_TEST_OBJECTS 256
+
+typedef struct {
+    TLAllocator* allocator;
+    void** objects;
+    u32 count;
+    u32 corrupted;
+} SharedTestWork;
+
+static void* shared_test_free_all(void* argument) {
+    SharedTestWork* work = argument;
+    for (u32 i = 0; i < work->count; ++i) {
+        tl_memory_free(work->allocator, work->objects[i]);
+    }
+
+    return NULL;
+}
+
+static void* scratch_test_worker(void* argument) {
+    u32* rounds = argument;
+    for (u32 round = 0; round < 256; ++round) {
+        TLAllocator* scratch = tl_memory_scratch();
+        u32* value = tl_memory_alloc(scratch, TL_MEMORY_BLOCK, sizeof(u32));
+        *value = round;
+        if (*value == round) (*rounds)++;
+        tl_memory_scratch_release();
+    }
+
+    return NULL;
+}
+
+static void* shared_test_alloc_free(void* argument) {
+    SharedTestWork* work = argument;
+    work->objects[0] = tl_memory_alloc(work->allocator, TL_MEMORY_BLOCK, 64);
+    tl_memory_free(work->allocator, work->objects[0]);
+    return NULL;
+}
+
+static void* shared_test_churn(void* argument) {
+    SharedTestWork* work = argument;
+    for (u32 round = 0; round < 64; ++round) {
+        for (u32 i = 0; i < work->count; ++i) {
+            u32* object = tl_memory_alloc(work->allocator, TL_MEMORY_BLOCK, 16 + (i % 8) * 32);
+            object[0] = round;
+            object[1] = i;
+            work->objects[i] = object;
+        }
+
+        for (u32 i = 0; i < work->count; ++i) {
+            const u32* object = work->objects[i];
+            if (object[0] != round || object[1] != i) work->corrupted++;
+            tl_memory_free(work->allocator, work->objects[i]);
+        }
+    }
+
+    return NULL;
+}
+
+static TLAllocator* m_budget_heap = NULL;
+static void* m_budget_cache = NULL;
+static u32 m_budget_events = 0;
+static u32 m_budget_percent = 0;
+
+// Counts the pressure raised by the budget tests and drops their cache
+static TLEventStatus budget_test_pressure(const TLEvent* event) {
+    const b8 tagged = event->u64[1] == 0 && event->u32[0] == TL_MEMORY_ECS_COMPONENT;
+    const b8 owned = m_budget_heap != NULL && event->u64[1] == (u64)(uintptr_t)m_budget_heap;
+    if (!tagged && !owned) return TL_EVENT_AVAILABLE;
+
+    m_budget_events++;
+    m_budget_percent = event->u32[1];
+    if (m_budget_cache != NULL) {
+        tl_memory_free(m_budget_heap, m_budget_cache);
+        m_budget_cache = NULL;
+    }
+
+    return TL_EVENT_AVAILABLE;
+}
+
 void test_memory(void) {
     TEST_SUITE_BEGIN("Memory");
 
@@ -48,6 +127,59 @@ void test_memory(void) {
     }
     TEST_END();
 
+    TEST_BEGIN("linear_allocator_grows_without_moving");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(256, TL_ALLOCATOR_LINEAR);
+
+        u32* values[200];
+        for (u32 i = 0; i < 200; i++) {
+            values[i] = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 40);
+            *values[i] = i;
+        }
+
+        for (u32 i = 0; i < 200; i++) {
+            ASSERT_EQ(i, *values[i]);
+        }
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    TEST_BEGIN("linear_allocator_oversized_request");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(256, TL_ALLOCATOR_LINEAR);
+
+        u8* small = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 16);
+        u8* large = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, TL_KIBI_BYTES(8));
+        ASSERT_NOT_NULL(large);
+        tl_memory_set(large, 0x7F, TL_KIBI_BYTES(8));
+
+        // The current page keeps serving small requests
+        u8* next = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 16);
+        ASSERT_TRUE(next > small && next < small + 256);
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    TEST_BEGIN("linear_allocator_reset_reuses_pages");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(128, TL_ALLOCATOR_LINEAR);
+
+        void* first = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 64);
+        for (u32 i = 0; i < 16; i++) {
+            tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 64);
+        }
+
+        tl_memory_allocator_reset(alloc);
+
+        u8* again = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 64);
+        ASSERT_TRUE(first == (void*)again);
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
     // ============================================
     // Dynamic Allocator
     // ============================================
@@ -92,6 +224,711 @@ void test_memory(void) {
     }
     TEST_END();
 
+    TEST_BEGIN("dynamic_allocator_free_interleaved");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(0, TL_ALLOCATOR_DYNAMIC);
+
+        u8* ptrs[16];
+        for (int i = 0; i < 16; i++) {
+            ptrs[i] = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 32 + i);
+            ASSERT_NOT_NULL(ptrs[i]);
+            tl_memory_set(ptrs[i], (i32)i, 32 + i);
+        }
+
+        // Free from the middle, head and tail of the live list
+        const int order[16] = { 7, 15, 0, 3, 12, 8, 1, 14, 5, 10, 2, 13, 6, 9, 4, 11 };
+        for (int i = 0; i < 16; i++) {
+            const int index = order[i];
+            ASSERT_EQ(ptrs[index][31 + index], (u8)index);
+            tl_memory_free(alloc, ptrs[index]);
+        }
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+#if defined(TELEIOS_BUILD_DEBUG)
+    TEST_BEGIN("dynamic_allocator_interns_stack_traces");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(0, TL_ALLOCATOR_DYNAMIC);
+        void* blocks[64];
+
+        // Same call stack every time, stored once
+        blocks[0] = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 32);
+        const u32 interned = tl_profiler_stacktrace_count();
+        for (u32 i = 1; i < 64; i++) {
+            blocks[i] = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 32);
+        }
+
+        ASSERT_EQ(interned, tl_profiler_stacktrace_count());
+
+        for (u32 i = 0; i < 64; i++) {
+            tl_memory_free(alloc, blocks[i]);
+        }
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+#endif
+
+    // ============================================
+    // Slab Allocator
+    // ============================================
+
+    TEST_BEGIN("slab_allocator_alloc_free");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(0, TL_ALLOCATOR_SLAB);
+        ASSERT_NOT_NULL(alloc);
+
+        u8* ptr = tl_memory_alloc(alloc, TL_MEMORY_CONTAINER_NODE, 24);
+        ASSERT_NOT_NULL(ptr);
+
+        tl_memory_free(alloc, ptr);
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    TEST_BEGIN("slab_allocator_reuses_freed_object");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(0, TL_ALLOCATOR_SLAB);
+
+        u8* first = tl_memory_alloc(alloc, TL_MEMORY_STRING, 40);
+        tl_memory_set(first, 0xAB, 40);
+        tl_memory_free(alloc, first);
+
+        // Same size class comes back from the free list
+        u8* second = tl_memory_alloc_zeroed(alloc, TL_MEMORY_STRING, 64);
+        ASSERT_TRUE(first == second);
+        ASSERT_EQ(0, second[0]);
+        ASSERT_EQ(0, second[63]);
+
+        tl_memory_free(alloc, second);
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    TEST_BEGIN("slab_allocator_many_objects_across_slabs");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(0, TL_ALLOCATOR_SLAB);
+
+        u32* ptrs[512];
+        for (u32 i = 0; i < 512; i++) {
+            ptrs[i] = tl_memory_alloc(alloc, TL_MEMORY_CONTAINER_NODE, 1 + (i % 128));
+            ASSERT_NOT_NULL(ptrs[i]);
+            *ptrs[i] = i;
+        }
+
+        for (u32 i = 0; i < 512; i++) {
+            ASSERT_EQ(i, *ptrs[i]);
+        }
+
+        for (u32 i = 0; i < 512; i += 2) tl_memory_free(alloc, ptrs[i]);
+        for (u32 i = 1; i < 512; i += 2) tl_memory_free(alloc, ptrs[i]);
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    TEST_BEGIN("slab_allocator_large_allocation");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(0, TL_ALLOCATOR_SLAB);
+
+        u8* small = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 16);
+        u8* large = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, TL_KIBI_BYTES(16));
+        ASSERT_NOT_NULL(large);
+        tl_memory_set(large, 0x5A, TL_KIBI_BYTES(16));
+        ASSERT_EQ(0x5A, large[TL_KIBI_BYTES(16) - 1]);
+
+        tl_memory_free(alloc, large);
+        tl_memory_free(alloc, small);
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    // ============================================
+    // Shared Allocator
+    // ============================================
+
+    TEST_BEGIN("shared_allocator_reuses_freed_object");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(0, TL_ALLOCATOR_SHARED);
+
+        void* first = tl_memory_alloc(alloc, TL_MEMORY_STRING, 40);
+        tl_memory_free(alloc, first);
+
+        // Comes straight back from the thread's magazine
+        void* second = tl_memory_alloc(alloc, TL_MEMORY_STRING, 64);
+        ASSERT_TRUE(first == second);
+
+        // Oversize requests bypass the magazines
+        u8* large = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 3000);
+        tl_memory_set(large, 0x5A, 3000);
+        ASSERT_EQ(0x5A, large[2999]);
+
+        tl_memory_free(alloc, large);
+        tl_memory_free(alloc, second);
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    TEST_BEGIN("shared_allocator_cross_thread_free");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(0, TL_ALLOCATOR_SHARED);
+        void* objects[SHARED_TEST_OBJECTS];
+        for (u32 i = 0; i < SHARED_TEST_OBJECTS; ++i) {
+            objects[i] = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 48);
+        }
+
+        SharedTestWork work = { alloc, objects, SHARED_TEST_OBJECTS, 0 };
+        TLThread* worker = tl_thread_create(global->allocator, shared_test_free_all, &work);
+        ASSERT_TRUE(tl_thread_join(worker, NULL));
+
+        // The worker's full magazines reach this thread through the depot
+        u32 reused = 0;
+        void* again[SHARED_TEST_OBJECTS];
+        for (u32 i = 0; i < SHARED_TEST_OBJECTS; ++i) {
+            again[i] = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 48);
+            for (u32 j = 0; j < SHARED_TEST_OBJECTS; ++j) {
+                if (again[i] == objects[j]) {
+                    reused++;
+                    break;
+                }
+            }
+        }
+        ASSERT_TRUE(reused > 0);
+
+        for (u32 i = 0; i < SHARED_TEST_OBJECTS; ++i) {
+            tl_memory_free(alloc, again[i]);
+        }
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    TEST_BEGIN("shared_allocator_concurrent_threads");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(0, TL_ALLOCATOR_SHARED);
+        void* first[SHARED_TEST_OBJECTS];
+        void* second[SHARED_TEST_OBJECTS];
+
+        SharedTestWork works[2] = {
+            { alloc, first, SHARED_TEST_OBJECTS, 0 },
+            { alloc, second, SHARED_TEST_OBJECTS, 0 },
+        };
+
+        TLThread* a = tl_thread_create(global->allocator, shared_test_churn, &works[0]);
+        TLThread* b = tl_thread_create(global->allocator, shared_test_churn, &works[1]);
+        ASSERT_TRUE(tl_thread_join(a, NULL));
+        ASSERT_TRUE(tl_thread_join(b, NULL));
+
+        ASSERT_EQ(0, works[0].corrupted);
+        ASSERT_EQ(0, works[1].corrupted);
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    TEST_BEGIN("shared_allocator_thread_exit_returns_cache");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(0, TL_ALLOCATOR_SHARED);
+        void* freed = NULL;
+
+        SharedTestWork work = { alloc, &freed, 1, 0 };
+        TLThread* worker = tl_thread_create(global->allocator, shared_test_alloc_free, &work);
+        ASSERT_TRUE(tl_thread_join(worker, NULL));
+
+        // The ended thread's magazine is this thread's first refill
+        void* object = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 64);
+        ASSERT_TRUE(object == freed);
+
+        tl_memory_free(alloc, object);
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    // ============================================
+    // Frame Allocator
+    // ============================================
+
+    TEST_BEGIN("frame_allocator_alloc_reset");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(TL_KIBI_BYTES(1), TL_ALLOCATOR_FRAME);
+        ASSERT_NOT_NULL(alloc);
+
+        void* first = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 100);
+        void* second = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 200);
+        ASSERT_NOT_NULL(first);
+        ASSERT_NOT_NULL(second);
+        ASSERT_TRUE(tl_memory_frame_allocated(alloc) >= 300);
+
+        tl_memory_allocator_reset(alloc);
+        ASSERT_EQ(0, tl_memory_frame_allocated(alloc));
+        ASSERT_TRUE(tl_memory_frame_peak(alloc) >= 300);
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    TEST_BEGIN("frame_allocator_previous_frame_survives_one_reset");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(TL_KIBI_BYTES(1), TL_ALLOCATOR_FRAME);
+
+        u32* frame_n = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, sizeof(u32));
+        *frame_n = 0xCAFE;
+
+        // Frame N+1 allocates from the other buffer
+        tl_memory_allocator_reset(alloc);
+        u32* frame_n1 = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, sizeof(u32));
+        *frame_n1 = 0xBEEF;
+        ASSERT_TRUE(frame_n != frame_n1);
+        ASSERT_EQ(0xCAFE, *frame_n);
+
+        // Frame N+2 recycles the buffer of frame N
+        tl_memory_allocator_reset(alloc);
+        u32* frame_n2 = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, sizeof(u32));
+        ASSERT_TRUE(frame_n == frame_n2);
+        ASSERT_EQ(0xBEEF, *frame_n1);
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    // ============================================
+    // Stack Allocator
+    // ============================================
+
+    TEST_BEGIN("stack_allocator_marker_rewind");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(TL_KIBI_BYTES(1), TL_ALLOCATOR_STACK);
+        ASSERT_NOT_NULL(alloc);
+
+        void* outer = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 64);
+        const TLMemoryMarker marker = tl_memory_stack_push_marker(alloc);
+
+        void* inner = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 128);
+        ASSERT_NOT_NULL(inner);
+        ASSERT_TRUE(inner != outer);
+
+        // Rewinding hands the same bytes out again
+        tl_memory_stack_pop_to_marker(alloc, marker);
+        void* again = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 128);
+        ASSERT_TRUE(again == inner);
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    TEST_BEGIN("stack_allocator_grows_across_chunks");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(256, TL_ALLOCATOR_STACK);
+        const TLMemoryMarker marker = tl_memory_stack_push_marker(alloc);
+
+        u32* values[32];
+        for (u32 i = 0; i < 32; i++) {
+            values[i] = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 48);
+            *values[i] = i;
+        }
+
+        // Bigger than a chunk gets a dedicated one
+        u8* big = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, TL_KIBI_BYTES(2));
+        tl_memory_set(big, 0x11, TL_KIBI_BYTES(2));
+
+        for (u32 i = 0; i < 32; i++) {
+            ASSERT_EQ(i, *values[i]);
+        }
+
+        tl_memory_stack_pop_to_marker(alloc, marker);
+        void* first = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 48);
+        ASSERT_TRUE(first == (void*)values[0]);
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    TEST_BEGIN("scratch_allocator_nested_scopes");
+    {
+        TLAllocator* scratch = tl_memory_scratch();
+        ASSERT_NOT_NULL(scratch);
+        ASSERT_TRUE(scratch == tl_memory_scratch());
+
+        const TLMemoryMarker outer = tl_memory_stack_push_marker(scratch);
+        TLString* kept = tl_string_create(scratch, "outer");
+
+        const TLMemoryMarker inner = tl_memory_stack_push_marker(scratch);
+        TLString* temporary = tl_string_create(scratch, "inner");
+        ASSERT_TRUE(tl_string_equals_cstr(temporary, "inner"));
+        tl_memory_stack_pop_to_marker(scratch, inner);
+
+        ASSERT_TRUE(tl_string_equals_cstr(kept, "outer"));
+        tl_memory_stack_pop_to_marker(scratch, outer);
+    }
+    TEST_END();
+
+    TEST_BEGIN("scratch_allocator_per_thread_while_stats_roll");
+    {
+        // Workers register and unregister their scratch while this thread walks the registry
+        u32 rounds[4] = { 0 };
+        TLThread* workers[4];
+        for (u32 i = 0; i < 4; ++i) workers[i] = tl_thread_create(global->allocator, scratch_test_worker, &rounds[i]);
+        for (u32 i = 0; i < 2000; ++i) tl_memory_stats_frame();
+        for (u32 i = 0; i < 4; ++i) ASSERT_TRUE(tl_thread_join(workers[i], NULL));
+
+        for (u32 i = 0; i < 4; ++i) ASSERT_EQ(256, rounds[i]);
+    }
+    TEST_END();
+
+    // ============================================
+    // Virtual Allocator
+    // ============================================
+
+    TEST_BEGIN("virtual_allocator_contiguous_growth");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(TL_MEBI_BYTES(64), TL_ALLOCATOR_VIRTUAL);
+        ASSERT_NOT_NULL(alloc);
+
+        // Spans several commit steps without relocating
+        u8* first = tl_memory_alloc(alloc, TL_MEMORY_SCENE, 1000);
+        u8* previous = first;
+        for (u32 i = 0; i < 300; i++) {
+            u8* block = tl_memory_alloc(alloc, TL_MEMORY_SCENE, 1000);
+            ASSERT_TRUE(block > previous);
+            block[999] = (u8)i;
+            previous = block;
+        }
+
+        ASSERT_TRUE((u64)(previous - first) < TL_MEBI_BYTES(1));
+
+        tl_memory_allocator_reset(alloc);
+        u8* again = tl_memory_alloc(alloc, TL_MEMORY_SCENE, 1000);
+        ASSERT_TRUE(again == first);
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    TEST_BEGIN("virtual_allocator_huge_pages");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(TL_MEBI_BYTES(16), TL_ALLOCATOR_VIRTUAL);
+        tl_memory_virtual_set_huge_pages(alloc, true);
+
+        u8* block = tl_memory_alloc(alloc, TL_MEMORY_SCENE, TL_MEBI_BYTES(3));
+        ASSERT_NOT_NULL(block);
+        ASSERT_EQ(0, ((uintptr_t)block) % TL_MEBI_BYTES(2));
+        tl_memory_set(block, 0x42, TL_MEBI_BYTES(3));
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    // ============================================
+    // Zeroed Allocation
+    // ============================================
+
+    TEST_BEGIN("memory_alloc_zeroed_clears_recycled_memory");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(TL_KIBI_BYTES(4), TL_ALLOCATOR_LINEAR);
+
+        u8* dirty = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 256);
+        tl_memory_set(dirty, 0xAB, 256);
+        tl_memory_allocator_reset(alloc);
+
+        u8* clean = tl_memory_alloc_zeroed(alloc, TL_MEMORY_BLOCK, 256);
+        ASSERT_TRUE(dirty == clean);
+        for (u32 i = 0; i < 256; i++) {
+            ASSERT_EQ(0, clean[i]);
+        }
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    // ============================================
+    // Aligned Allocation
+    // ============================================
+
+    TEST_BEGIN("memory_alloc_aligned_all_allocators");
+    {
+        const TLAllocatorType types[] = {
+            TL_ALLOCATOR_LINEAR, TL_ALLOCATOR_DYNAMIC, TL_ALLOCATOR_SLAB,
+            TL_ALLOCATOR_FRAME, TL_ALLOCATOR_STACK, TL_ALLOCATOR_VIRTUAL
+        };
+        const u32 alignments[] = { 32, 64, 256, 2048, 4096 };
+
+        for (u32 t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+            TLAllocator* alloc = tl_memory_allocator_create(TL_MEBI_BYTES(1), types[t]);
+            ASSERT_NOT_NULL(alloc);
+
+            for (u32 a = 0; a < sizeof(alignments) / sizeof(alignments[0]); a++) {
+                if (types[t] == TL_ALLOCATOR_SLAB && alignments[a] > 2048) continue;
+
+                // Odd sizes knock the next request off any natural boundary
+                for (u32 size = 24; size <= 1000; size += 488) {
+                    u8* block = tl_memory_alloc_aligned(alloc, TL_MEMORY_GRAPHICS, size, alignments[a]);
+                    ASSERT_NOT_NULL(block);
+                    ASSERT_EQ(0, ((uintptr_t)block) % alignments[a]);
+                    tl_memory_set(block, 0x5A, size);
+
+                    if (types[t] == TL_ALLOCATOR_DYNAMIC || types[t] == TL_ALLOCATOR_SLAB) {
+                        tl_memory_free(alloc, block);
+                    }
+                }
+            }
+
+            tl_memory_allocator_destroy(alloc);
+        }
+    }
+    TEST_END();
+
+    // ============================================
+    // Realloc
+    // ============================================
+
+    TEST_BEGIN("memory_realloc_linear_extends_last_block");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(TL_KIBI_BYTES(4), TL_ALLOCATOR_LINEAR);
+
+        u8* block = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 64);
+        tl_memory_set(block, 0x11, 64);
+
+        u8* grown = tl_memory_realloc(alloc, TL_MEMORY_BLOCK, block, 64, 512);
+        ASSERT_TRUE(grown == block);
+        ASSERT_EQ(0x11, grown[63]);
+
+        // Something allocated behind it forces a copy
+        u8* other = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 16);
+        u8* moved = tl_memory_realloc(alloc, TL_MEMORY_BLOCK, grown, 512, 1024);
+        ASSERT_TRUE(moved != grown);
+        ASSERT_TRUE(moved > other);
+        ASSERT_EQ(0x11, moved[0]);
+        ASSERT_EQ(0x11, moved[63]);
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    TEST_BEGIN("memory_realloc_dynamic_keeps_contents");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(0, TL_ALLOCATOR_DYNAMIC);
+
+        u8* first = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 32);
+        u32* values = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, sizeof(u32) * 4);
+        u8* last = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 32);
+        for (u32 i = 0; i < 4; i++) values[i] = i + 1;
+
+        // Large enough for the heap to move or remap it
+        values = tl_memory_realloc(alloc, TL_MEMORY_BLOCK, values, sizeof(u32) * 4, TL_MEBI_BYTES(1));
+        ASSERT_EQ(4, values[3]);
+
+        // The live list survives the move
+        tl_memory_free(alloc, first);
+        tl_memory_free(alloc, values);
+        tl_memory_free(alloc, last);
+
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    TEST_BEGIN("memory_realloc_dynamic_grows_step_by_step");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(0, TL_ALLOCATOR_DYNAMIC);
+
+        // Whether the heap grows in place or moves, the contents and the boundary survive
+        u8* block = tl_memory_alloc(alloc, TL_MEMORY_BLOCK, 64);
+        for (u32 i = 0; i < 64; i++) block[i] = (u8)i;
+        for (u32 size = 64; size < 64 + 16 * 200; size += 16) {
+            block = tl_memory_realloc(alloc, TL_MEMORY_BLOCK, block, size, size + 16);
+            ASSERT_EQ(0, ((uintptr_t)block) % alignof(max_align_t));
+            for (u32 i = size; i < size + 16; i++) block[i] = (u8)i;
+        }
+
+        b8 intact = true;
+        for (u32 i = 0; i < 64 + 16 * 200; i++) {
+            if (block[i] != (u8)i) intact = false;
+        }
+        ASSERT_TRUE(intact);
+
+        // Over-aligned blocks keep their boundary when they move
+        u8* aligned = tl_memory_alloc_aligned(alloc, TL_MEMORY_BLOCK, 64, 64);
+        aligned[0] = 0x3C;
+        for (u32 size = 64; size < 64 + 16 * 20; size += 16) {
+            aligned = tl_memory_realloc(alloc, TL_MEMORY_BLOCK, aligned, size, size + 16);
+            ASSERT_EQ(0, ((uintptr_t)aligned) % 64);
+        }
+        ASSERT_EQ(0x3C, aligned[0]);
+
+        tl_memory_free(alloc, aligned);
+        tl_memory_free(alloc, block);
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    TEST_BEGIN("memory_realloc_slab_stays_within_class");
+    {
+        TLAllocator* alloc = tl_memory_allocator_create(0, TL_ALLOCATOR_SLAB);
+
+        u8* block = tl_memory_alloc(alloc, TL_MEMORY_CONTAINER_NODE, 20);
+        block[0] = 0x7F;
+
+        // 20 bytes live in the 32 byte class
+        ASSERT_TRUE(tl_memory_realloc(alloc, TL_MEMORY_CONTAINER_NODE, block, 20, 32) == block);
+
+        u8* moved = tl_memory_realloc(alloc, TL_MEMORY_CONTAINER_NODE, block, 32, 100);
+        ASSERT_TRUE(moved != block);
+        ASSERT_EQ(0x7F, moved[0]);
+
+        tl_memory_free(alloc, moved);
+        tl_memory_allocator_destroy(alloc);
+    }
+    TEST_END();
+
+    // ============================================
+    // Telemetry
+    // ============================================
+
+    TEST_BEGIN("memory_stats_track_tags_and_allocators");
+    {
+        TLAllocator* heap = tl_memory_allocator_create(0, TL_ALLOCATOR_DYNAMIC);
+        TLAllocator* arena = tl_memory_allocator_create(TL_KIBI_BYTES(4), TL_ALLOCATOR_LINEAR);
+        TLAllocator* slab = tl_memory_allocator_create(0, TL_ALLOCATOR_SLAB);
+        const TLMemoryStats before = tl_memory_stats_tag(TL_MEMORY_ULID);
+
+        void* block = tl_memory_alloc(heap, TL_MEMORY_ULID, 100);
+        tl_memory_alloc(arena, TL_MEMORY_ULID, 50);
+        void* object = tl_memory_alloc(slab, TL_MEMORY_ULID, 20);
+
+        // The SLAB object occupies its 32 byte class
+        TLMemoryStats during = tl_memory_stats_tag(TL_MEMORY_ULID);
+        ASSERT_EQ(before.current_bytes + 182, during.current_bytes);
+        ASSERT_EQ(before.allocation_count + 3, during.allocation_count);
+        ASSERT_TRUE(during.peak_bytes >= during.current_bytes);
+        ASSERT_EQ(100, tl_memory_stats_allocator(heap).current_bytes);
+
+        block = tl_memory_realloc(heap, TL_MEMORY_ULID, block, 100, 300);
+        ASSERT_EQ(300, tl_memory_stats_allocator(heap).current_bytes);
+        ASSERT_EQ(1, tl_memory_stats_allocator(heap).allocation_count);
+
+        tl_memory_free(heap, block);
+        tl_memory_free(slab, object);
+        tl_memory_allocator_reset(arena);
+
+        const TLMemoryStats after = tl_memory_stats_tag(TL_MEMORY_ULID);
+        ASSERT_EQ(before.current_bytes, after.current_bytes);
+        ASSERT_EQ(0, tl_memory_stats_allocator(heap).current_bytes);
+        ASSERT_EQ(300, tl_memory_stats_allocator(heap).peak_bytes);
+
+        tl_memory_allocator_destroy(slab);
+        tl_memory_allocator_destroy(arena);
+        tl_memory_allocator_destroy(heap);
+    }
+    TEST_END();
+
+    TEST_BEGIN("memory_stats_frame_allocations");
+    {
+        TLAllocator* arena = tl_memory_allocator_create(TL_KIBI_BYTES(4), TL_ALLOCATOR_FRAME);
+
+        tl_memory_stats_frame();
+        for (u32 i = 0; i < 3; i++) tl_memory_alloc(arena, TL_MEMORY_SCENE, 16);
+        tl_memory_stats_frame();
+        ASSERT_EQ(3, tl_memory_stats_allocator(arena).frame_allocations);
+
+        tl_memory_stats_frame();
+        ASSERT_EQ(0, tl_memory_stats_allocator(arena).frame_allocations);
+
+        tl_memory_allocator_destroy(arena);
+    }
+    TEST_END();
+
+    TEST_BEGIN("memory_stats_frame_previous_buffer_stays_live");
+    {
+        TLAllocator* arena = tl_memory_allocator_create(TL_KIBI_BYTES(4), TL_ALLOCATOR_FRAME);
+        const u64 base = tl_memory_stats_tag(TL_MEMORY_SCENE).current_bytes;
+
+        tl_memory_alloc(arena, TL_MEMORY_SCENE, 100);
+        tl_memory_allocator_reset(arena);
+
+        // Frame N is still readable during frame N+1
+        ASSERT_EQ(100, tl_memory_stats_allocator(arena).current_bytes);
+        ASSERT_EQ(base + 100, tl_memory_stats_tag(TL_MEMORY_SCENE).current_bytes);
+
+        tl_memory_alloc(arena, TL_MEMORY_SCENE, 40);
+        ASSERT_EQ(140, tl_memory_stats_allocator(arena).current_bytes);
+
+        // Frame N+2 recycles the buffer of frame N only
+        tl_memory_allocator_reset(arena);
+        ASSERT_EQ(40, tl_memory_stats_allocator(arena).current_bytes);
+        ASSERT_EQ(base + 40, tl_memory_stats_tag(TL_MEMORY_SCENE).current_bytes);
+
+        tl_memory_allocator_reset(arena);
+        ASSERT_EQ(0, tl_memory_stats_allocator(arena).current_bytes);
+        ASSERT_EQ(base, tl_memory_stats_tag(TL_MEMORY_SCENE).current_bytes);
+
+        tl_memory_allocator_destroy(arena);
+    }
+    TEST_END();
+
+    // ============================================
+    // Budgets
+    // ============================================
+
+    tl_event_subscribe(TL_EVENT_MEMORY_PRESSURE, budget_test_pressure);
+
+    TEST_BEGIN("memory_budget_tag_soft_threshold");
+    {
+        TLAllocator* heap = tl_memory_allocator_create(0, TL_ALLOCATOR_DYNAMIC);
+        const u64 base = tl_memory_stats_tag(TL_MEMORY_ECS_COMPONENT).current_bytes;
+        tl_memory_budget_tag(TL_MEMORY_ECS_COMPONENT, base + 1000, 50);
+        m_budget_events = 0;
+
+        void* first = tl_memory_alloc(heap, TL_MEMORY_ECS_COMPONENT, 400);
+        ASSERT_EQ(0, m_budget_events);
+
+        // Crossing the soft threshold is reported once
+        void* second = tl_memory_alloc(heap, TL_MEMORY_ECS_COMPONENT, 200);
+        ASSERT_EQ(1, m_budget_events);
+        void* third = tl_memory_alloc(heap, TL_MEMORY_ECS_COMPONENT, 100);
+        ASSERT_EQ(1, m_budget_events);
+
+        // Dropping below it re-arms the threshold
+        tl_memory_free(heap, second);
+        tl_memory_free(heap, third);
+        second = tl_memory_alloc(heap, TL_MEMORY_ECS_COMPONENT, 300);
+        ASSERT_EQ(2, m_budget_events);
+
+        tl_memory_free(heap, first);
+        tl_memory_free(heap, second);
+        tl_memory_budget_tag(TL_MEMORY_ECS_COMPONENT, 0, 0);
+        tl_memory_allocator_destroy(heap);
+    }
+    TEST_END();
+
+    TEST_BEGIN("memory_budget_allocator_limit_evicts");
+    {
+        m_budget_heap = tl_memory_allocator_create(0, TL_ALLOCATOR_DYNAMIC);
+        tl_memory_budget_allocator(m_budget_heap, 1000, 0);
+        m_budget_events = 0;
+
+        // The default 80% threshold is crossed, the handler evicts the cache
+        m_budget_cache = tl_memory_alloc(m_budget_heap, TL_MEMORY_BLOCK, 500);
+        void* block = tl_memory_alloc(m_budget_heap, TL_MEMORY_BLOCK, 400);
+        ASSERT_EQ(1, m_budget_events);
+        ASSERT_EQ(90, m_budget_percent);
+        ASSERT_TRUE(m_budget_cache == NULL);
+
+        // Past the limit the eviction brings usage back under it and the allocation survives
+        m_budget_cache = tl_memory_alloc(m_budget_heap, TL_MEMORY_BLOCK, 300);
+        void* large = tl_memory_alloc(m_budget_heap, TL_MEMORY_BLOCK, 500);
+        ASSERT_EQ(2, m_budget_events);
+        ASSERT_EQ(120, m_budget_percent);
+        ASSERT_TRUE(m_budget_cache == NULL);
+        ASSERT_EQ(900, tl_memory_stats_allocator(m_budget_heap).current_bytes);
+
+        tl_memory_free(m_budget_heap, block);
+        tl_memory_free(m_budget_heap, large);
+        tl_memory_allocator_destroy(m_budget_heap);
+        m_budget_heap = NULL;
+    }
+    TEST_END();
+
     // ============================================
     // Memory Operations
     // ============================================
@@ -0,0 +1,374 @@
+#include "test_framework.h"
+#include "teleios/teleios.h"
+
+#define PROFILER_TEST_EVENTS 64
+
+// Discards whatever earlier tests left in the ring buffers
+static void profiler_test_drain(void) {
+    TLProfilerZoneEvent events[PROFILER_TEST_EVENTS];
+    while (tl_profiler_zones_collect(events, PROFILER_TEST_EVENTS) > 0) { }
+}
+
+static const TLProfilerZoneEvent* profiler_test_find(const TLProfilerZoneEvent* events, const u32 count, const char* name) {
+    for (u32 i = 0; i < count; ++i) {
+        if (strcmp(events[i].zone->name, name) == 0) return &events[i];
+    }
+
+    return NULL;
+}
+
+static void* profiler_test_worker(void* argument) {
+    u64* thread = argument;
+    *thread = tl_thread_current_id();
+
+    TL_PROFILER_ZONE_BEGIN(worker, "test_worker")
+    tl_thread_sleep(1);
+    TL_PROFILER_ZONE_END(worker)
+
+    return NULL;
+}
+
+#if defined(TELEIOS_BUILD_DEBUG)
+// Same call site every time, only the arguments change. Allocators snapshot
+// the stack they are created from.
+static void profiler_test_snapshot(const char* name, const u32 value) {
+    tl_profiler_frame_push("test_profiler.c", 1, "profiler_test_snapshot", "%s, %u, %.1f, %c, %llu, %%", name, value, 1.5, 'x', 42ULL);
+    TLAllocator* allocator = tl_memory_allocator_create(0, TL_ALLOCATOR_DYNAMIC);
+    tl_memory_allocator_destroy(allocator);
+    tl_profiler_frame_pop();
+}
+#endif
+
+#if TELEIOS_THREAD_CONTENTION
+static void* profiler_test_locker(void* argument) {
+    TLMutex* mutex = argument;
+    tl_mutex_lock(mutex);
+    tl_mutex_unlock(mutex);
+    return NULL;
+}
+#endif
+
+void test_profiler(void) {
+    TEST_SUITE_BEGIN("Profiler");
+
+    const b8 enabled = tl_profiler_zones_enabled();
+
+    // ============================================
+    // Timed Zones
+    // ============================================
+
+    TEST_BEGIN("profiler_zones_disabled_record_nothing");
+    {
+        tl_profiler_zones_enable(false);
+        profiler_test_drain();
+
+        ASSERT_EQ(0, tl_profiler_zone_begin());
+
+        TL_PROFILER_ZONE_BEGIN(idle, "test_idle")
+        TL_PROFILER_ZONE_END(idle)
+
+        TLProfilerZoneEvent events[PROFILER_TEST_EVENTS];
+        ASSERT_EQ(0, tl_profiler_zones_collect(events, PROFILER_TEST_EVENTS));
+    }
+    TEST_END();
+
+    TEST_BEGIN("profiler_zones_nested");
+    {
+        tl_profiler_zones_enable(true);
+        profiler_test_drain();
+
+        TL_PROFILER_ZONE_BEGIN(outer, "test_outer")
+        TL_PROFILER_ZONE_BEGIN(inner, "test_inner")
+        tl_thread_sleep(1);
+        TL_PROFILER_ZONE_END(inner)
+        TL_PROFILER_ZONE_END(outer)
+
+        TLProfilerZoneEvent events[PROFILER_TEST_EVENTS];
+        const u32 count = tl_profiler_zones_collect(events, PROFILER_TEST_EVENTS);
+        ASSERT_EQ(2, count);
+
+        const TLProfilerZoneEvent* first = profiler_test_find(events, count, "test_outer");
+        const TLProfilerZoneEvent* second = profiler_test_find(events, count, "test_inner");
+        ASSERT_NOT_NULL(first);
+        ASSERT_NOT_NULL(second);
+        ASSERT_TRUE(first->begin <= second->begin);
+        ASSERT_TRUE(second->end <= first->end);
+        ASSERT_TRUE(second->end - second->begin >= 500000);
+        ASSERT_EQ(tl_thread_current_id(), first->thread);
+        ASSERT_STR_EQ("test_profiler", first->zone->function);
+    }
+    TEST_END();
+
+    TEST_BEGIN("profiler_zones_collect_respects_capacity");
+    {
+        tl_profiler_zones_enable(true);
+        profiler_test_drain();
+
+        for (u32 i = 0; i < 10; ++i) {
+            TL_PROFILER_ZONE_BEGIN(repeated, "test_repeated")
+            TL_PROFILER_ZONE_END(repeated)
+        }
+
+        TLProfilerZoneEvent events[PROFILER_TEST_EVENTS];
+        ASSERT_EQ(4, tl_profiler_zones_collect(events, 4));
+        ASSERT_EQ(6, tl_profiler_zones_collect(events, PROFILER_TEST_EVENTS));
+        ASSERT_EQ(0, tl_profiler_zones_collect(events, PROFILER_TEST_EVENTS));
+    }
+    TEST_END();
+
+    TEST_BEGIN("profiler_zones_from_other_threads");
+    {
+        tl_profiler_zones_enable(true);
+        profiler_test_drain();
+
+        u64 thread = 0;
+        TLThread* worker = tl_thread_create(global->allocator, profiler_test_worker, &thread);
+        ASSERT_TRUE(tl_thread_join(worker, NULL));
+
+        TLProfilerZoneEvent events[PROFILER_TEST_EVENTS];
+        const u32 count = tl_profiler_zones_collect(events, PROFILER_TEST_EVENTS);
+        const TLProfilerZoneEvent* event = profiler_test_find(events, count, "test_worker");
+        ASSERT_NOT_NULL(event);
+        ASSERT_EQ(thread, event->thread);
+    }
+    TEST_END();
+
+    TEST_BEGIN("profiler_frame_mark_instant");
+    {
+        tl_profiler_zones_enable(true);
+        profiler_test_drain();
+
+        tl_profiler_frame_mark(42);
+
+        TLProfilerZoneEvent events[PROFILER_TEST_EVENTS];
+        const u32 count = tl_profiler_zones_collect(events, PROFILER_TEST_EVENTS);
+        ASSERT_EQ(1, count);
+        ASSERT_EQ(TL_PROFILER_EVENT_INSTANT, events[0].type);
+        ASSERT_EQ(42, events[0].value);
+        ASSERT_EQ(events[0].begin, events[0].end);
+        ASSERT_STR_EQ("frame", events[0].zone->name);
+    }
+    TEST_END();
+
+    TEST_BEGIN("profiler_counter_samples");
+    {
+        tl_profiler_zones_enable(false);
+        profiler_test_drain();
+
+        u32 evaluated = 0;
+        TL_PROFILER_COUNTER("test_counter", ++evaluated)
+        ASSERT_EQ(0, evaluated);
+
+        tl_profiler_zones_enable(true);
+        for (i64 value = -2; value <= 2; ++value) {
+            TL_PROFILER_COUNTER("test_counter", value * 1000)
+        }
+
+        TLProfilerZoneEvent events[PROFILER_TEST_EVENTS];
+        const u32 count = tl_profiler_zones_collect(events, PROFILER_TEST_EVENTS);
+        ASSERT_EQ(5, count);
+        ASSERT_EQ(TL_PROFILER_EVENT_COUNTER, events[0].type);
+        ASSERT_EQ(-2000, (i64)events[0].value);
+        ASSERT_EQ(2000, (i64)events[4].value);
+        ASSERT_EQ(events[0].zone, events[4].zone);
+        ASSERT_STR_EQ("test_counter", events[0].zone->name);
+    }
+    TEST_END();
+
+    // ============================================
+    // Stack Frames
+    // ============================================
+
+#if defined(TELEIOS_BUILD_DEBUG)
+    TEST_BEGIN("profiler_stacktrace_deferred_arguments");
+    {
+        // Without kept arguments the text is never built, only the sites count
+        profiler_test_snapshot("first", 1);
+        const u32 plain = tl_profiler_stacktrace_count();
+        profiler_test_snapshot("second", 2);
+        ASSERT_EQ(plain, tl_profiler_stacktrace_count());
+
+        tl_profiler_stacktrace_keep_arguments(true);
+        profiler_test_snapshot("first", 1);
+        ASSERT_EQ(plain + 1, tl_profiler_stacktrace_count());
+        profiler_test_snapshot("first", 1);
+        ASSERT_EQ(plain + 1, tl_profiler_stacktrace_count());
+        profiler_test_snapshot("first", 2);
+        ASSERT_EQ(plain + 2, tl_profiler_stacktrace_count());
+        profiler_test_snapshot("other", 1);
+        ASSERT_EQ(plain + 3, tl_profiler_stacktrace_count());
+        tl_profiler_stacktrace_keep_arguments(false);
+    }
+    TEST_END();
+#endif
+
+    // ============================================
+    // Trace Export
+    // ============================================
+
+    TEST_BEGIN("profiler_trace_export");
+    {
+        const char* path = "test_profiler_trace.json";
+        tl_profiler_zones_enable(false);
+        profiler_test_drain();
+
+        tl_profiler_thread_name("test \"main\"");
+        ASSERT_TRUE(tl_profiler_trace_begin(path));
+        ASSERT_TRUE(tl_profiler_zones_enabled());
+        ASSERT_FALSE(tl_profiler_trace_begin(path));
+
+        TL_PROFILER_ZONE_BEGIN(traced, "test_traced")
+        TL_PROFILER_ZONE_END(traced)
+        tl_profiler_trace_flush();
+        tl_profiler_frame_mark(7);
+        TL_PROFILER_COUNTER("test_traced_counter", -3)
+        tl_profiler_trace_end();
+        tl_profiler_thread_name("main");
+
+        char buffer[4096] = { 0 };
+        FILE* file = fopen(path, "r");
+        ASSERT_NOT_NULL(file);
+        const size_t length = fread(buffer, 1, sizeof(buffer) - 1, file);
+        fclose(file);
+        remove(path);
+
+        ASSERT_TRUE(length > 0);
+        ASSERT_EQ('[', buffer[0]);
+        ASSERT_NOT_NULL(strstr(buffer, "\"name\":\"test_traced\",\"cat\":\"zone\",\"ph\":\"X\""));
+        ASSERT_NOT_NULL(strstr(buffer, "\"ph\":\"i\""));
+        ASSERT_NOT_NULL(strstr(buffer, "\"args\":{\"frame\":7}"));
+        ASSERT_NOT_NULL(strstr(buffer, "\"name\":\"test_traced_counter\",\"cat\":\"counter\",\"ph\":\"C\""));
+        ASSERT_NOT_NULL(strstr(buffer, "\"args\":{\"value\":-3}"));
+        ASSERT_NOT_NULL(strstr(buffer, "\"args\":{\"name\":\"test \\\"main\\\"\"}"));
+        ASSERT_NOT_NULL(strstr(buffer, "\n]\n"));
+    }
+    TEST_END();
+
+    // ============================================
+    // Frame Statistics
+    // ============================================
+
+    TEST_BEGIN("profiler_phase_percentiles");
+    {
+        tl_profiler_phase_reset();
+        for (u64 i = 1; i <= 100; ++i) {
+            tl_profiler_phase_record(TL_PROFILER_PHASE_UPDATE, i * 1000);
+        }
+
+        // Histogram buckets are at most 1/16 wide, and never report below the value
+        TLProfilerPhaseStats stats;
+        tl_profiler_phase_stats(TL_PROFILER_PHASE_UPDATE, &stats);
+        ASSERT_EQ(100, stats.samples);
+        ASSERT_TRUE(stats.p50 >= 50000 && stats.p50 <= 50000 + 50000 / 16);
+        ASSERT_TRUE(stats.p95 >= 95000 && stats.p95 <= 95000 + 95000 / 16);
+        ASSERT_TRUE(stats.p99 >= 99000 && stats.p99 <= 100000);
+        ASSERT_EQ(100000, stats.maximum);
+
+        tl_profiler_phase_stats(TL_PROFILER_PHASE_STEP, &stats);
+        ASSERT_EQ(0, stats.samples);
+        ASSERT_EQ(0, stats.p99);
+    }
+    TEST_END();
+
+    TEST_BEGIN("profiler_phase_hitch_and_dump");
+    {
+        tl_profiler_phase_reset();
+        for (u32 i = 0; i < 199; ++i) {
+            tl_profiler_phase_record(TL_PROFILER_PHASE_FRAME, 1000000);
+        }
+        tl_profiler_phase_record(TL_PROFILER_PHASE_FRAME, 50000000);
+        tl_profiler_phase_record(TL_PROFILER_PHASE_EVENTS, 7);
+
+        TLProfilerPhaseStats stats;
+        tl_profiler_phase_stats(TL_PROFILER_PHASE_FRAME, &stats);
+        ASSERT_TRUE(stats.p99 < 1100000);
+        ASSERT_EQ(50000000, stats.maximum);
+
+        tl_profiler_phase_stats(TL_PROFILER_PHASE_EVENTS, &stats);
+        ASSERT_EQ(7, stats.p50);
+
+        // The dump starts a new window
+        tl_profiler_phase_dump();
+        tl_profiler_phase_stats(TL_PROFILER_PHASE_FRAME, &stats);
+        ASSERT_EQ(0, stats.samples);
+        ASSERT_STR_EQ("frame_begin", tl_profiler_phase_name(TL_PROFILER_PHASE_FRAME_BEGIN));
+    }
+    TEST_END();
+
+    // ============================================
+    // Lock Contention
+    // ============================================
+
+#if TELEIOS_THREAD_CONTENTION
+    TEST_BEGIN("profiler_mutex_uncontended");
+    {
+        TLMutexStats stats;
+        ASSERT_FALSE(tl_mutex_stats("test_unknown_mutex", &stats));
+
+        TLMutex* mutex = tl_mutex_create(global->allocator, "test_mutex");
+        for (u32 i = 0; i < 10; ++i) {
+            tl_mutex_lock(mutex);
+            tl_mutex_unlock(mutex);
+        }
+
+        ASSERT_TRUE(tl_mutex_stats("test_mutex", &stats));
+        ASSERT_EQ(10, stats.acquisitions);
+        ASSERT_EQ(0, stats.contended);
+        ASSERT_EQ(0, stats.wait_total);
+        tl_mutex_destroy(mutex);
+    }
+    TEST_END();
+
+    TEST_BEGIN("profiler_mutex_contended");
+    {
+        TLMutex* mutex = tl_mutex_create(global->allocator, "test_contended_mutex");
+        tl_mutex_lock(mutex);
+
+        TLThread* worker = tl_thread_create(global->allocator, profiler_test_locker, mutex);
+        tl_thread_sleep(20);
+        tl_mutex_unlock(mutex);
+        ASSERT_TRUE(tl_thread_join(worker, NULL));
+
+        TLMutexStats stats;
+        ASSERT_TRUE(tl_mutex_stats("test_contended_mutex", &stats));
+        ASSERT_EQ(2, stats.acquisitions);
+        ASSERT_EQ(1, stats.contended);
+        ASSERT_TRUE(stats.wait_maximum >= 10000000);
+        ASSERT_EQ(stats.wait_total, stats.wait_maximum);
+        ASSERT_TRUE(stats.hold_maximum >= 10000000);
+
+        // Every mutex of a name feeds the same statistics
+        TLMutex* other = tl_mutex_create(global->allocator, "test_contended_mutex");
+        tl_mutex_lock(other);
+        tl_mutex_unlock(other);
+        ASSERT_TRUE(tl_mutex_stats("test_contended_mutex", &stats));
+        ASSERT_EQ(3, stats.acquisitions);
+
+        tl_mutex_destroy(other);
+        tl_mutex_destroy(mutex);
+    }
+    TEST_END();
+
+    TEST_BEGIN("profiler_mutex_condition_wait_not_held");
+    {
+        TLMutex* mutex = tl_mutex_create(global->allocator, "test_condition_mutex");
+        TLCondition* condition = tl_condition_create(global->allocator);
+
+        tl_mutex_lock(mutex);
+        ASSERT_FALSE(tl_condition_wait_timeout(condition, mutex, 20));
+        tl_mutex_unlock(mutex);
+
+        TLMutexStats stats;
+        ASSERT_TRUE(tl_mutex_stats("test_condition_mutex", &stats));
+        ASSERT_TRUE(stats.hold_total < 10000000);
+
+        tl_condition_destroy(condition);
+        tl_mutex_destroy(mutex);
+    }
+    TEST_END();
+#endif
+
+    tl_profiler_zones_enable(enabled);
+
+    TEST_SUITE_END();
+}
@@ -0,0 +1,33 @@
+#include "teleios/teleios.h"
+#include <stdio.h>
+
+// Usage: teleios_logdecode <binary log> [output]
+//
+// Turns a file written by tl_logger_binary_begin() back into the usual log
+// lines, on stdout unless an output file is given.
+int main(const int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "Usage: %s <binary log> [output]\n", argv[0]);
+        return 1;
+    }
+
+    FILE* input = fopen(argv[1], "rb");
+    if (input == NULL) {
+        fprintf(stderr, "Failed to open %s\n", argv[1]);
+        return 1;
+    }
+
+    FILE* output = argc == 3 ? fopen(argv[2], "w") : stdout;
+    if (output == NULL) {
+        fprintf(stderr, "Failed to create %s\n", argv[2]);
+        fclose(input);
+        return 1;
+    }
+
+    const b8 decoded = tl_logger_binary_decode(input, output);
+    if (!decoded) fprintf(stderr, "%s is not a binary log or is truncated\n", argv[1]);
+
+    if (output != stdout) fclose(output);
+    fclose(input);
+    return decoded ? 0 : 2;
+}